@@ -1,8 +1,27 @@
 #include "APosableCharacter.h"
+#include "demo_ik.h"
+#include "DirtyPoseableMeshComponent.h"
+#include "HandIKSolver.h"
+#include "HandIKQuery.h"
+#include "IKCapsuleProxies.h"
+#include "IKReachabilityGrid.h"
+#include "ProceduralOscillatorSubsystem.h"
 #include "Engine/StaticMesh.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "UObject/ConstructorHelpers.h"
 #include "Engine/Engine.h"  // for logging
+#include "GameFramework/PlayerController.h"
+#include "Net/UnrealNetwork.h"
+#include "Engine/NetDriver.h"
+#include "Engine/SkeletalMesh.h"
+#include "Async/ParallelFor.h"
+
+DECLARE_CYCLE_STAT(TEXT("Hand IK Solve"), STAT_HandIKSolve, STATGROUP_DemoIK);
+
+// Bones of the arm chain driven by the hand IK.
+static const FName handIK_upperArmBoneName("upperarm_r");
+static const FName handIK_lowerArmBoneName("lowerarm_r");
+static const FName handIK_handBoneName("hand_r");
 
 // Sets default values
 AAPosableCharacter::AAPosableCharacter()
@@ -10,7 +29,7 @@ AAPosableCharacter::AAPosableCharacter()
 	PrimaryActorTick.bCanEverTick = true;
 
 	// Create and attach the PoseableMeshComponent.
-	posableMeshComponent_reference = CreateDefaultSubobject<UPoseableMeshComponent>(TEXT("PoseableMesh"));
+	posableMeshComponent_reference = CreateDefaultSubobject<UDirtyPoseableMeshComponent>(TEXT("PoseableMesh"));
 	posableMeshComponent_reference->SetMobility(EComponentMobility::Movable);
 	posableMeshComponent_reference->SetVisibility(true);
 	posableMeshComponent_reference->SetupAttachment(RootComponent);
@@ -81,13 +100,30 @@ bool AAPosableCharacter::initializePosableMesh()
 		return false;
 	}
 
-	posableMeshComponent_reference->SetSkinnedAssetAndUpdate(default_skeletalMesh_reference);
+	// The constructor usually assigned the mesh already; reassigning would reallocate all the bone data.
+	if (posableMeshComponent_reference->GetSkinnedAsset() != default_skeletalMesh_reference)
+	{
+		posableMeshComponent_reference->SetSkinnedAssetAndUpdate(default_skeletalMesh_reference);
+	}
 	return true;
 }
 
 void AAPosableCharacter::waving_playStop()
 {
 	session1_isPlaying = !session1_isPlaying;
+
+	// Only playing characters take part in the batched oscillator evaluation.
+	if (UProceduralOscillatorSubsystem* oscillators = GetWorld() ? GetWorld()->GetSubsystem<UProceduralOscillatorSubsystem>() : nullptr)
+	{
+		if (session1_isPlaying)
+		{
+			oscillators->registerChannels(this, waving_activeOscillatorChannels);
+		}
+		else
+		{
+			oscillators->unregisterChannels(this);
+		}
+	}
 }
 
 void AAPosableCharacter::testSetTargetSphereRelativePosition()
@@ -131,7 +167,14 @@ void AAPosableCharacter::setVisibility(bool visible)
 	}
 }
 
-void AAPosableCharacter::storeCurrentPoseRotations(TArray<FRotator>& storedPose)
+void AAPosableCharacter::setBoneComponentRotation(FName BoneName, const FRotator& Rotation)
+{
+	// Report the write so the next refresh only recomputes this bone and its descendants.
+	posableMeshComponent_reference->SetBoneRotationByName(BoneName, Rotation, EBoneSpaces::ComponentSpace);
+	posableMeshComponent_reference->markBoneDirty(BoneName);
+}
+
+void AAPosableCharacter::storeCurrentPoseRotations(TArray<FQuat4f>& storedPose)
 {
 	if (!posableMeshComponent_reference)
 	{
@@ -147,7 +190,7 @@ void AAPosableCharacter::storeCurrentPoseRotations(TArray<FRotator>& storedPose)
 		FName BoneName = posableMeshComponent_reference->GetBoneName(BoneIndex);
 		if (BoneName != NAME_None)
 		{
-			storedPose[BoneIndex] = posableMeshComponent_reference->GetBoneRotationByName(BoneName, EBoneSpaces::ComponentSpace);
+			storedPose[BoneIndex] = FQuat4f(posableMeshComponent_reference->GetBoneRotationByName(BoneName, EBoneSpaces::ComponentSpace).Quaternion());
 		}
 	}
 }
@@ -172,7 +215,7 @@ void AAPosableCharacter::waving_initializeStartingPose()
 		FRotator relativeBoneRotation(21.435965f, 21.709806f, -92.235083f);
 		boneRelTransform.SetRotation(relativeBoneRotation.Quaternion());
 		FTransform newBoneTransformWorld = boneRelTransform * parentCompTransform;
-		posableMeshComponent_reference->SetBoneRotationByName(upperArmBoneName, newBoneTransformWorld.Rotator(), EBoneSpaces::ComponentSpace);
+		setBoneComponentRotation(upperArmBoneName, newBoneTransformWorld.Rotator());
 	}
 	else
 	{
@@ -187,7 +230,7 @@ void AAPosableCharacter::waving_initializeStartingPose()
 		FRotator relativeBoneRotation(-78.486128f, 177.309228f, 13.290207f);
 		boneRelTransform.SetRotation(relativeBoneRotation.Quaternion());
 		FTransform newBoneTransformWorld = boneRelTransform * parentCompTransform;
-		posableMeshComponent_reference->SetBoneRotationByName(clavicleBoneName, newBoneTransformWorld.Rotator(), EBoneSpaces::ComponentSpace);
+		setBoneComponentRotation(clavicleBoneName, newBoneTransformWorld.Rotator());
 	}
 	else
 	{
@@ -197,6 +240,61 @@ void AAPosableCharacter::waving_initializeStartingPose()
 	posableMeshComponent_reference->RefreshBoneTransforms();
 }
 
+void AAPosableCharacter::waving_initializeOscillators()
+{
+	// Without authored channels, reproduce the original head nod: yaw during the first half of
+	// a 4 second cycle (scaled by waving_animationSpeed), pitch during the second half.
+	// The generated channels never go into the edited property, so they follow speed and amplitude edits.
+	waving_activeOscillatorChannels = waving_oscillatorChannels;
+	if (waving_activeOscillatorChannels.Num() == 0)
+	{
+		FProceduralOscillatorChannel nodChannel;
+		nodChannel.BoneName = FName("head");
+		nodChannel.Frequency = waving_animationSpeed / 4.0f;
+		nodChannel.Amplitude = waving_amplitude;
+		nodChannel.BlendCurve = EOscillatorBlendCurve::HalfSine;
+
+		nodChannel.Axis = EOscillatorAxis::Yaw;
+		nodChannel.Phase = 0.0f;
+		waving_activeOscillatorChannels.Add(nodChannel);
+
+		nodChannel.Axis = EOscillatorAxis::Pitch;
+		nodChannel.Phase = 0.5f;
+		waving_activeOscillatorChannels.Add(nodChannel);
+	}
+	waving_activeAnimationSpeed = waving_animationSpeed;
+	waving_activeAmplitude = waving_amplitude;
+
+	// Map each channel to a unique animated bone, kept parent-first so parents are posed before children.
+	waving_oscillatorBoneIndices.Reset();
+	for (const FProceduralOscillatorChannel& channel : waving_activeOscillatorChannels)
+	{
+		const int32 boneIndex = posableMeshComponent_reference->GetBoneIndex(channel.BoneName);
+		if (boneIndex == INDEX_NONE)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Bone %s not found!"), *channel.BoneName.ToString());
+			continue;
+		}
+		waving_oscillatorBoneIndices.AddUnique(boneIndex);
+	}
+	waving_oscillatorBoneIndices.Sort();
+
+	waving_oscillatorChannelSlots.Reset(waving_activeOscillatorChannels.Num());
+	for (const FProceduralOscillatorChannel& channel : waving_activeOscillatorChannels)
+	{
+		waving_oscillatorChannelSlots.Add(waving_oscillatorBoneIndices.Find(posableMeshComponent_reference->GetBoneIndex(channel.BoneName)));
+	}
+
+	// A playing character swaps its registered channels in place.
+	if (session1_isPlaying)
+	{
+		if (UProceduralOscillatorSubsystem* oscillators = GetWorld() ? GetWorld()->GetSubsystem<UProceduralOscillatorSubsystem>() : nullptr)
+		{
+			oscillators->registerChannels(this, waving_activeOscillatorChannels);
+		}
+	}
+}
+
 void AAPosableCharacter::waving_tickAnimation()
 {
 	if (!posableMeshComponent_reference)
@@ -205,7 +303,6 @@ void AAPosableCharacter::waving_tickAnimation()
 		return;
 	}
 
-	const float currentTime = GetWorld()->GetTimeSeconds();
 	const int32 numBones = posableMeshComponent_reference->GetNumBones();
 	if (waving_initialBoneRotations.Num() != numBones)
 	{
@@ -213,126 +310,128 @@ void AAPosableCharacter::waving_tickAnimation()
 		return;
 	}
 
-	// Target the head bone for the nodding animation.
-	FName headBoneName = FName("head");  // Adjust if your head bone has a different name.
-
-	if (doesBoneOrSocketNameExists(headBoneName))
+	// The default nod is generated from speed and amplitude, so rebuild it when either changed.
+	if (waving_oscillatorChannels.Num() == 0 && (waving_activeAnimationSpeed != waving_animationSpeed || waving_activeAmplitude != waving_amplitude))
 	{
-		// Reset the head to its stored initial rotation.
-		FTransform boneCompTransform = posableMeshComponent_reference->GetBoneTransformByName(headBoneName, EBoneSpaces::ComponentSpace);
-		int currentBoneIndex = posableMeshComponent_reference->GetBoneIndex(headBoneName);
-		FRotator storedRotation = waving_initialBoneRotations[currentBoneIndex];
-		boneCompTransform.SetRotation(storedRotation.Quaternion());
-
-		// Retrieve the parent's transform.
-		FTransform parentCompTransform = posableMeshComponent_reference->GetBoneTransformByName(
-			posableMeshComponent_reference->GetParentBone(headBoneName),
-			EBoneSpaces::ComponentSpace);
-		FTransform boneRelTransform = boneCompTransform.GetRelativeTransform(parentCompTransform);
+		waving_initializeOscillators();
+	}
 
-		// Define a cycle for the head animation.
-		float cycleDuration = 4.0f;  // total cycle duration in seconds (adjust as needed)
-		float t = FMath::Fmod(currentTime * waving_animationSpeed, cycleDuration);
+	// The subsystem evaluates every character's channels in one batch; we only read our slice.
+	UProceduralOscillatorSubsystem* oscillators = GetWorld()->GetSubsystem<UProceduralOscillatorSubsystem>();
+	const TArrayView<const float> channelValues = oscillators ? oscillators->getChannelValues(this) : TArrayView<const float>();
+	if (channelValues.Num() != waving_oscillatorChannelSlots.Num())
+	{
+		return;
+	}
 
-		FRotator rotationOffset = FRotator::ZeroRotator;
-		if (t < cycleDuration / 2.0f)
+	// Sum the channel angles per animated bone.
+	TArray<FRotator, TInlineAllocator<16>> rotationOffsets;
+	rotationOffsets.Init(FRotator::ZeroRotator, waving_oscillatorBoneIndices.Num());
+	for (int32 channelIndex = 0; channelIndex < channelValues.Num(); channelIndex++)
+	{
+		const int32 slot = waving_oscillatorChannelSlots[channelIndex];
+		if (slot == INDEX_NONE)
 		{
-			// First half: head nods left to right (adjust yaw).
-			float phase = t / (cycleDuration / 2.0f); // Phase from 0 to 1.
-			rotationOffset.Yaw = FMath::Sin(phase * PI) * waving_amplitude;
+			continue;
 		}
-		else
+		switch (waving_activeOscillatorChannels[channelIndex].Axis)
 		{
-			// Second half: head nods front to back (adjust pitch).
-			float phase = (t - cycleDuration / 2.0f) / (cycleDuration / 2.0f); // Phase from 0 to 1.
-			rotationOffset.Pitch = FMath::Sin(phase * PI) * waving_amplitude;
+		case EOscillatorAxis::Roll:
+			rotationOffsets[slot].Roll += channelValues[channelIndex];
+			break;
+		case EOscillatorAxis::Pitch:
+			rotationOffsets[slot].Pitch += channelValues[channelIndex];
+			break;
+		case EOscillatorAxis::Yaw:
+			rotationOffsets[slot].Yaw += channelValues[channelIndex];
+			break;
 		}
+	}
+
+	for (int32 slot = 0; slot < waving_oscillatorBoneIndices.Num(); slot++)
+	{
+		const int32 currentBoneIndex = waving_oscillatorBoneIndices[slot];
+		const FName boneName = posableMeshComponent_reference->GetBoneName(currentBoneIndex);
+
+		// Reset the bone to its stored initial rotation.
+		FTransform boneCompTransform = posableMeshComponent_reference->GetBoneTransformByName(boneName, EBoneSpaces::ComponentSpace);
+		boneCompTransform.SetRotation(FQuat(waving_initialBoneRotations[currentBoneIndex]));
+
+		// Retrieve the parent's transform.
+		FTransform parentCompTransform = posableMeshComponent_reference->GetBoneTransformByName(
+			posableMeshComponent_reference->GetParentBone(boneName),
+			EBoneSpaces::ComponentSpace);
+		FTransform boneRelTransform = boneCompTransform.GetRelativeTransform(parentCompTransform);
 
-		// Combine the original relative rotation with the computed offset.
-		FRotator relativeBoneRotation = boneRelTransform.Rotator() + rotationOffset;
+		// Combine the original relative rotation with the oscillator offset.
+		FRotator relativeBoneRotation = boneRelTransform.Rotator() + rotationOffsets[slot];
 		boneRelTransform.SetRotation(relativeBoneRotation.Quaternion());
 
 		// Reconstruct the new world transform and apply the updated rotation.
 		FTransform newBoneTransformWorld = boneRelTransform * parentCompTransform;
-		posableMeshComponent_reference->SetBoneRotationByName(headBoneName, newBoneTransformWorld.Rotator(), EBoneSpaces::ComponentSpace);
-	}
-	else
-	{
-		UE_LOG(LogTemp, Warning, TEXT("Bone %s not found!"), *headBoneName.ToString());
+		setBoneComponentRotation(boneName, newBoneTransformWorld.Rotator());
 	}
 }
 
 // --- NEW: Hand IK using a simple FABRIK algorithm for a 3-bone chain (upperarm, lowerarm, hand) ---
 void AAPosableCharacter::handIK_tickAnimation()
 {
-	// Define bone names for the arm.
-	FName upperArmBoneName = FName("upperarm_r");
-	FName lowerArmBoneName = FName("lowerarm_r");
-	FName handBoneName = FName("hand_r");
-
-	if (!(doesBoneOrSocketNameExists(upperArmBoneName) &&
-		doesBoneOrSocketNameExists(lowerArmBoneName) &&
-		doesBoneOrSocketNameExists(handBoneName)))
+	if (!posableMeshComponent_reference)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("One or more arm bones not found!"));
+		UE_LOG(LogTemp, Warning, TEXT("Posable mesh component not attached or registered"));
 		return;
 	}
 
-	// Get current bone transforms (positions in component space).
-	FTransform upperArmTransform = posableMeshComponent_reference->GetBoneTransformByName(upperArmBoneName, EBoneSpaces::ComponentSpace);
-	FTransform lowerArmTransform = posableMeshComponent_reference->GetBoneTransformByName(lowerArmBoneName, EBoneSpaces::ComponentSpace);
-	FTransform handTransform = posableMeshComponent_reference->GetBoneTransformByName(handBoneName, EBoneSpaces::ComponentSpace);
-
-	FVector p0 = upperArmTransform.GetLocation();
-	FVector p1 = lowerArmTransform.GetLocation();
-	FVector p2 = handTransform.GetLocation();
+	// The chain is read from the cached component space pose: bring in this frame's earlier writes
+	// (oscillator channels on the spine or clavicle) first. Only their subtrees are recomputed.
+	posableMeshComponent_reference->RefreshBoneTransforms();
 
-	// Use the target spheres world location as the IK target.
-	FVector targetPos = targetSphere->GetComponentLocation();
+	// The solve runs in float: component space offsets are small, so we convert once here
+	// and once more when writing the rotations back.
+	FHandIKChainBones bones;
+	FHandIKChain3f chain;
+	if (!handIK_resolveChain(bones, chain))
+	{
+		return;
+	}
 
-	// Compute bone lengths.
-	float len1 = (p1 - p0).Size();
-	float len2 = (p2 - p1).Size();
-	float totalLength = len1 + len2;
-	float distToTarget = (targetPos - p0).Size();
+	// Use the target spheres location, brought into component space, as the IK target.
+	const FVector3f targetPos = FVector3f(posableMeshComponent_reference->GetComponentTransform().InverseTransformPosition(targetSphere->GetComponentLocation()));
 
-	// If the target is unreachable, fully extend the arm.
-	if (distToTarget >= totalLength)
+	// Keep the arm out of the torso using the precomputed body capsules.
+	FHandIKSolveSettings solveSettings;
+	if (handIK_avoidSelfCollision)
 	{
-		FVector dir = (targetPos - p0).GetSafeNormal();
-		p1 = p0 + dir * len1;
-		p2 = p1 + dir * len2;
+		handIK_updateBoneCapsules();
+		handIK_gatherCapsules(handIK_componentSpaceCapsules);
+		solveSettings.Capsules = handIK_componentSpaceCapsules;
 	}
-	else
+
 	{
-		// Use a simple FABRIK iteration.
-		const int maxIterations = 10;
-		const float tolerance = 0.1f;
-		FVector originalRoot = p0;
+		SCOPE_CYCLE_COUNTER(STAT_HandIKSolve);
 
-		for (int iter = 0; iter < maxIterations; iter++)
+		// With a baked grid, start from the stored seed: reachable targets only need a couple of
+		// iterations and unreachable ones are settled by the lookup alone.
+		FIKReachabilityCell reachabilityCell;
+		if (handIK_reachabilityGrid && handIK_reachabilityGrid->lookup(targetPos - chain.Root, reachabilityCell))
 		{
-			// Backward pass: set end effector to target.
-			p2 = targetPos;
-			FVector dir = (p1 - p2).GetSafeNormal();
-			p1 = p2 + dir * len2;
-
-			// Forward pass: fix root and update intermediate joint.
-			p0 = originalRoot;
-			dir = (p1 - p0).GetSafeNormal();
-			p1 = p0 + dir * len1;
-
-			// Update end effector.
-			dir = (p2 - p1).GetSafeNormal();
-			p2 = p1 + dir * len2;
-
-			if ((p2 - targetPos).Size() < tolerance)
+			SeedHandIKChain(chain, reachabilityCell.SeedMidDirection, targetPos, solveSettings.Capsules);
+			if (reachabilityCell.bReachable)
 			{
-				break;
+				solveSettings.MaxIterations = handIK_seededIterations;
+				SolveHandIKFABRIK(chain, targetPos, solveSettings);
 			}
 		}
+		else
+		{
+			SolveHandIKFABRIK(chain, targetPos, solveSettings);
+		}
 	}
 
+	const FVector p0 = FVector(chain.Root);
+	const FVector p1 = FVector(chain.Mid);
+	const FVector p2 = FVector(chain.End);
+
 	// Compute new rotations based on the new joint positions.
 	// For upper arm: aim from p0 to p1.
 	FVector newDirUpper = (p1 - p0).GetSafeNormal();
@@ -351,38 +450,37 @@ void AAPosableCharacter::handIK_tickAnimation()
 
 	// Optional natural posing: smoothly blend from the stored rotation to the new one.
 	// Here we use the stored rotation for the lower arm as a base.
-	int lowerArmIndex = posableMeshComponent_reference->GetBoneIndex(lowerArmBoneName);
-	FRotator storedLowerRotation = waving_initialBoneRotations.IsValidIndex(lowerArmIndex) ? waving_initialBoneRotations[lowerArmIndex] : FRotator::ZeroRotator;
+	FRotator storedLowerRotation = waving_initialBoneRotations.IsValidIndex(bones.LowerArm) ? FRotator(FQuat(waving_initialBoneRotations[bones.LowerArm])) : FRotator::ZeroRotator;
 	newRotLower = FMath::RInterpTo(storedLowerRotation, newRotLower, GetWorld()->DeltaTimeSeconds, 5.0f);
 
 	// --- Advanced Feature: Motion Capture Integration (Dummy) ---
 	// If enabled, override the computed rotations with those from the motion capture data.
 	if (bUseMotionCaptureData)
 	{
-		if (MotionCaptureBoneRotations.Contains(upperArmBoneName))
+		if (MotionCaptureBoneRotations.Contains(handIK_upperArmBoneName))
 		{
-			newRotUpper = MotionCaptureBoneRotations[upperArmBoneName];
+			newRotUpper = MotionCaptureBoneRotations[handIK_upperArmBoneName];
 		}
-		if (MotionCaptureBoneRotations.Contains(lowerArmBoneName))
+		if (MotionCaptureBoneRotations.Contains(handIK_lowerArmBoneName))
 		{
-			newRotLower = MotionCaptureBoneRotations[lowerArmBoneName];
+			newRotLower = MotionCaptureBoneRotations[handIK_lowerArmBoneName];
 		}
 		// Optionally, update the hand bone as well if mocap data is provided.
 	}
 
 	// Convert world rotations to relative rotations based on parent bone transforms.
-	FName upperArmParent = posableMeshComponent_reference->GetParentBone(upperArmBoneName);
+	FName upperArmParent = posableMeshComponent_reference->GetParentBone(handIK_upperArmBoneName);
 	FTransform parentUpper = posableMeshComponent_reference->GetBoneTransformByName(upperArmParent, EBoneSpaces::ComponentSpace);
 	FTransform relTransformUpper = FTransform(newRotUpper) * parentUpper.Inverse();
-	posableMeshComponent_reference->SetBoneRotationByName(upperArmBoneName, relTransformUpper.Rotator(), EBoneSpaces::ComponentSpace);
+	setBoneComponentRotation(handIK_upperArmBoneName, relTransformUpper.Rotator());
 
-	FName lowerArmParent = upperArmBoneName; // lower arms parent is the upper arm.
+	FName lowerArmParent = handIK_upperArmBoneName; // lower arms parent is the upper arm.
 	FTransform parentLower = posableMeshComponent_reference->GetBoneTransformByName(lowerArmParent, EBoneSpaces::ComponentSpace);
 	FTransform relTransformLower = FTransform(newRotLower) * parentLower.Inverse();
-	posableMeshComponent_reference->SetBoneRotationByName(lowerArmBoneName, relTransformLower.Rotator(), EBoneSpaces::ComponentSpace);
+	setBoneComponentRotation(handIK_lowerArmBoneName, relTransformLower.Rotator());
 
 	// Optionally, set the hands rotation (here we reset it to zero).
-	posableMeshComponent_reference->SetBoneRotationByName(handBoneName, FRotator::ZeroRotator, EBoneSpaces::ComponentSpace);
+	setBoneComponentRotation(handIK_handBoneName, FRotator::ZeroRotator);
 
 	posableMeshComponent_reference->RefreshBoneTransforms();
 }
@@ -413,6 +511,281 @@ void AAPosableCharacter::handIK_animateTarget(float DeltaTime)
 	setTargetSphereRelativePosition(newTargetPosition);
 }
 
+void AAPosableCharacter::handIK_cacheChainBones()
+{
+	handIK_chainBones = FHandIKChainBones();
+	if (posableMeshComponent_reference)
+	{
+		handIK_chainBones.UpperArm = posableMeshComponent_reference->GetBoneIndex(handIK_upperArmBoneName);
+		handIK_chainBones.LowerArm = posableMeshComponent_reference->GetBoneIndex(handIK_lowerArmBoneName);
+		handIK_chainBones.Hand = posableMeshComponent_reference->GetBoneIndex(handIK_handBoneName);
+	}
+}
+
+bool AAPosableCharacter::handIK_resolveChain(FHandIKChainBones& OutBones, FHandIKChain3f& OutChain) const
+{
+	if (!posableMeshComponent_reference)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Posable mesh component not attached or registered"));
+		return false;
+	}
+
+	const TArray<FTransform>& componentSpaceTransforms = posableMeshComponent_reference->GetComponentSpaceTransforms();
+	OutBones = handIK_chainBones;
+	if (!(componentSpaceTransforms.IsValidIndex(OutBones.UpperArm) &&
+		componentSpaceTransforms.IsValidIndex(OutBones.LowerArm) &&
+		componentSpaceTransforms.IsValidIndex(OutBones.Hand)))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("One or more arm bones not found!"));
+		return false;
+	}
+
+	OutChain.Root = FVector3f(componentSpaceTransforms[OutBones.UpperArm].GetLocation());
+	OutChain.Mid = FVector3f(componentSpaceTransforms[OutBones.LowerArm].GetLocation());
+	OutChain.End = FVector3f(componentSpaceTransforms[OutBones.Hand].GetLocation());
+	return true;
+}
+
+void AAPosableCharacter::handIK_updateBoneCapsules()
+{
+	handIK_boneCapsules = IKCapsuleProxies::GetOrBuild(Cast<USkeletalMesh>(posableMeshComponent_reference->GetSkinnedAsset()), handIK_upperArmBoneName, handIK_fallbackCapsuleRadius);
+}
+
+void AAPosableCharacter::handIK_gatherCapsules(TArray<FIKCapsuleProxy>& OutCapsules) const
+{
+	OutCapsules.Reset();
+	if (handIK_boneCapsules.IsValid())
+	{
+		IKCapsuleProxies::ToComponentSpace(*handIK_boneCapsules, *posableMeshComponent_reference, OutCapsules);
+	}
+}
+
+void AAPosableCharacter::handIK_benchmarkSelfCollision()
+{
+	FHandIKChainBones bones;
+	FHandIKChain3f restChain;
+	if (!handIK_resolveChain(bones, restChain))
+	{
+		return;
+	}
+	const float reach = (restChain.Mid - restChain.Root).Size() + (restChain.End - restChain.Mid).Size();
+
+	TArray<FIKCapsuleProxy> capsules;
+	handIK_updateBoneCapsules();
+	handIK_gatherCapsules(capsules);
+
+	// Same pseudo-random targets around the shoulder for both runs.
+	TArray<FVector3f> targets;
+	FRandomStream random(1234);
+	targets.SetNumUninitialized(handIK_benchmarkSolveCount);
+	for (FVector3f& target : targets)
+	{
+		target = restChain.Root + FVector3f(random.GetUnitVector()) * random.FRandRange(0.0f, reach * 1.1f);
+	}
+
+	// The solved hands are summed and logged, so the optimizer cannot drop the solves as unused.
+	auto timeSolves = [&](const FHandIKSolveSettings& settings, FVector3f& outHandSum)
+	{
+		outHandSum = FVector3f::ZeroVector;
+		const uint64 startCycles = FPlatformTime::Cycles64();
+		for (const FVector3f& target : targets)
+		{
+			FHandIKChain3f chain = restChain;
+			SolveHandIKFABRIK(chain, target, settings);
+			outHandSum += chain.End;
+		}
+		return FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - startCycles);
+	};
+
+	FHandIKSolveSettings unconstrained;
+	FHandIKSolveSettings constrained;
+	constrained.Capsules = capsules;
+
+	FVector3f unconstrainedHandSum;
+	FVector3f constrainedHandSum;
+	const double unconstrainedMs = timeSolves(unconstrained, unconstrainedHandSum);
+	const double constrainedMs = timeSolves(constrained, constrainedHandSum);
+	UE_LOG(LogTemp, Log, TEXT("Hand IK over %d solves: unconstrained %.3f us/solve, %d capsules %.3f us/solve (x%.2f), hand checksums %s / %s"),
+		targets.Num(),
+		unconstrainedMs * 1000.0 / FMath::Max(1, targets.Num()),
+		capsules.Num(),
+		constrainedMs * 1000.0 / FMath::Max(1, targets.Num()),
+		constrainedMs / FMath::Max(unconstrainedMs, UE_SMALL_NUMBER),
+		*unconstrainedHandSum.ToString(),
+		*constrainedHandSum.ToString());
+}
+
+FHandIKQueryContext AAPosableCharacter::makeHandIKQueryContext() const
+{
+	check(IsInGameThread());
+
+	FHandIKQueryContext context;
+	FHandIKChainBones bones;
+	if (!handIK_resolveChain(bones, context.RestChain))
+	{
+		return context;
+	}
+	context.ComponentToWorld = posableMeshComponent_reference->GetComponentTransform();
+
+	if (handIK_avoidSelfCollision)
+	{
+		handIK_gatherCapsules(context.Capsules);
+	}
+
+	context.ReachabilityGrid = handIK_reachabilityGrid;
+	if (handIK_reachabilityGrid)
+	{
+		context.ElbowMinBend = handIK_reachabilityGrid->bakedElbowMinBend;
+		context.ElbowMaxBend = handIK_reachabilityGrid->bakedElbowMaxBend;
+	}
+	context.SeededIterations = handIK_seededIterations;
+	context.ReachTolerance = handIK_queryReachTolerance;
+	context.bEnableJointLimits = bEnableJointLimits;
+	context.ElbowMinAngle = ElbowMinAngle;
+	context.ElbowMaxAngle = ElbowMaxAngle;
+	return context;
+}
+
+void AAPosableCharacter::queryHandIKReachability(const TArray<FVector>& WorldTargets, bool bComputeRotations, TArray<bool>& OutReachable, TArray<float>& OutResidualErrors, TArray<FRotator>& OutUpperArmRotations, TArray<FRotator>& OutLowerArmRotations) const
+{
+	const FHandIKQueryContext context = makeHandIKQueryContext();
+
+	TArray<FHandIKQueryResult> results;
+	results.SetNum(WorldTargets.Num());
+
+	// Spread larger batches over the task graph; each chunk only reads the shared snapshot.
+	const int32 chunkSize = 16;
+	const int32 numChunks = FMath::DivideAndRoundUp(WorldTargets.Num(), chunkSize);
+	ParallelFor(numChunks, [&](int32 chunkIndex)
+	{
+		const int32 start = chunkIndex * chunkSize;
+		const int32 count = FMath::Min(chunkSize, WorldTargets.Num() - start);
+		QueryHandIKBatch(context, TArrayView<const FVector>(WorldTargets).Slice(start, count), TArrayView<FHandIKQueryResult>(results).Slice(start, count), bComputeRotations);
+	});
+
+	OutReachable.SetNum(results.Num());
+	OutResidualErrors.SetNum(results.Num());
+	OutUpperArmRotations.SetNum(bComputeRotations ? results.Num() : 0);
+	OutLowerArmRotations.SetNum(bComputeRotations ? results.Num() : 0);
+	for (int32 i = 0; i < results.Num(); i++)
+	{
+		OutReachable[i] = results[i].bReachable;
+		OutResidualErrors[i] = results[i].ResidualError;
+		if (bComputeRotations)
+		{
+			OutUpperArmRotations[i] = FRotator(FQuat(results[i].UpperArmRotation));
+			OutLowerArmRotations[i] = FRotator(FQuat(results[i].LowerArmRotation));
+		}
+	}
+}
+
+bool AAPosableCharacter::handIK_resolveReplicatedBones()
+{
+	if (handIK_replicatedBoneIndices.Num() == handIK_replicatedBoneNames.Num())
+	{
+		return true;
+	}
+
+	handIK_replicatedBoneIndices.Reset();
+	for (const FName& boneName : handIK_replicatedBoneNames)
+	{
+		const int32 boneIndex = posableMeshComponent_reference->GetBoneIndex(boneName);
+		if (boneIndex == INDEX_NONE)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Bone %s not found!"), *boneName.ToString());
+			handIK_replicatedBoneIndices.Reset();
+			return false;
+		}
+		handIK_replicatedBoneIndices.Add(boneIndex);
+	}
+	return true;
+}
+
+float AAPosableCharacter::handIK_computeReplicationInterval() const
+{
+	// Significance is the distance to the closest viewer: nearby characters update at the fastest rate.
+	float closestViewerDistance = handIK_replicationFarDistance;
+	for (FConstPlayerControllerIterator it = GetWorld()->GetPlayerControllerIterator(); it; ++it)
+	{
+		if (const APlayerController* playerController = it->Get())
+		{
+			FVector viewLocation;
+			FRotator viewRotation;
+			playerController->GetPlayerViewPoint(viewLocation, viewRotation);
+			closestViewerDistance = FMath::Min(closestViewerDistance, static_cast<float>(FVector::Dist(viewLocation, GetActorLocation())));
+		}
+	}
+
+	return FMath::GetMappedRangeValueClamped(
+		FVector2f(handIK_replicationNearDistance, handIK_replicationFarDistance),
+		FVector2f(handIK_replicationMinInterval, handIK_replicationMaxInterval),
+		closestViewerDistance);
+}
+
+void AAPosableCharacter::handIK_replicatePose(float DeltaTime)
+{
+	handIK_timeSinceReplication += DeltaTime;
+	if (handIK_timeSinceReplication < handIK_computeReplicationInterval() || !handIK_resolveReplicatedBones())
+	{
+		return;
+	}
+	handIK_timeSinceReplication = 0.0f;
+
+	TArray<FQuat4f, TInlineAllocator<8>> rotations;
+	for (int32 boneIndex : handIK_replicatedBoneIndices)
+	{
+		rotations.Add(FQuat4f(posableMeshComponent_reference->BoneSpaceTransforms[boneIndex].GetRotation()));
+	}
+	handIK_replicatedPose.SetPose(rotations);
+	ForceNetUpdate();
+}
+
+void AAPosableCharacter::OnRep_handIKReplicatedPose()
+{
+	if (!handIK_resolveReplicatedBones() || handIK_replicatedPose.BoneRotations.Num() != handIK_replicatedBoneIndices.Num())
+	{
+		return;
+	}
+
+	// Apply the server's solve directly in bone space; no IK runs on this client.
+	for (int32 i = 0; i < handIK_replicatedBoneIndices.Num(); i++)
+	{
+		posableMeshComponent_reference->BoneSpaceTransforms[handIK_replicatedBoneIndices[i]].SetRotation(FQuat(handIK_replicatedPose.BoneRotations[i]));
+		posableMeshComponent_reference->markBoneDirty(handIK_replicatedBoneIndices[i]);
+	}
+	posableMeshComponent_reference->RefreshBoneTransforms();
+}
+
+void AAPosableCharacter::handIK_logBandwidth(float DeltaTime)
+{
+	handIK_bandwidthLogTime += DeltaTime;
+	if (handIK_bandwidthLogTime < 1.0f)
+	{
+		return;
+	}
+
+	// The server serializes the pose once per connection, so report what a single client costs.
+	const int32 bytes = handIK_replicatedPose.ConsumeSerializedBytes();
+	if (HasAuthority())
+	{
+		const UNetDriver* netDriver = GetNetDriver();
+		const int32 numConnections = netDriver ? netDriver->ClientConnections.Num() : 0;
+		UE_LOG(LogTemp, Log, TEXT("%s: hand IK pose sent %.1f bytes/s per connection (%d connections)"), *GetName(), static_cast<float>(bytes) / FMath::Max(1, numConnections) / handIK_bandwidthLogTime, numConnections);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Log, TEXT("%s: hand IK pose received %.1f bytes/s"), *GetName(), bytes / handIK_bandwidthLogTime);
+	}
+	handIK_bandwidthLogTime = 0.0f;
+}
+
+void AAPosableCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(AAPosableCharacter, handIK_replicatedPose);
+}
+
 void AAPosableCharacter::ToggleHandIK()
 {
 	handIK_isPlaying = !handIK_isPlaying;
@@ -428,10 +801,85 @@ void AAPosableCharacter::StartHandIKScriptedAnimation()
 void AAPosableCharacter::BeginPlay()
 {
 	Super::BeginPlay();
+
+	// Only characters that share their solved pose need a channel. SetReplicates also fixes up the
+	// remote role and the network actor list, which runtime spawns (the pool) rely on.
+	if (HasAuthority())
+	{
+		SetReplicates(handIK_replicateSolvedPose);
+	}
 	initializePosableMesh();
 	waving_initializeStartingPose();
 	waving_initialBoneRotations.Empty();
 	storeCurrentPoseRotations(waving_initialBoneRotations);
+	waving_initializeOscillators();
+
+	// Build the shared body capsules now, so const queries never have to touch the cache.
+	handIK_updateBoneCapsules();
+
+	// Kept so a pooled character can return to this state without running the setup again.
+	handIK_cacheChainBones();
+	pool_restPose = posableMeshComponent_reference->BoneSpaceTransforms;
+	pool_restHandIKIsPlaying = handIK_isPlaying;
+	pool_restTargetLocation = targetSphere ? targetSphere->GetRelativeLocation() : FVector::ZeroVector;
+}
+
+void AAPosableCharacter::pool_onAcquired()
+{
+	posableMeshComponent_reference->BoneSpaceTransforms = pool_restPose;
+	posableMeshComponent_reference->markAllBonesDirty();
+	posableMeshComponent_reference->RefreshBoneTransforms();
+
+	handIK_isPlaying = pool_restHandIKIsPlaying;
+	handIKAnimationTime = 0.0f;
+	setTargetSphereRelativePosition(pool_restTargetLocation);
+
+	// Start replicating from an empty pose so clients get a full pose again, not deltas of the last user.
+	handIK_replicatedPose = FIKReplicatedPose();
+	handIK_timeSinceReplication = 0.0f;
+	handIK_bandwidthLogTime = 0.0f;
+
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(true);
+}
+
+void AAPosableCharacter::pool_onReleased()
+{
+	if (session1_isPlaying)
+	{
+		waving_playStop();
+	}
+	handIKScriptedAnimationPlaying = false;
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+}
+
+#if WITH_EDITOR
+void AAPosableCharacter::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// Channel edits made while playing take effect right away.
+	const FName propertyName = PropertyChangedEvent.GetMemberPropertyName();
+	if (HasActorBegunPlay() && (propertyName == GET_MEMBER_NAME_CHECKED(AAPosableCharacter, waving_oscillatorChannels) ||
+		propertyName == GET_MEMBER_NAME_CHECKED(AAPosableCharacter, waving_animationSpeed) ||
+		propertyName == GET_MEMBER_NAME_CHECKED(AAPosableCharacter, waving_amplitude)))
+	{
+		waving_initializeOscillators();
+	}
+}
+#endif
+
+void AAPosableCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UProceduralOscillatorSubsystem* oscillators = GetWorld()->GetSubsystem<UProceduralOscillatorSubsystem>())
+	{
+		oscillators->unregisterChannels(this);
+	}
+	Super::EndPlay(EndPlayReason);
 }
 
 // Called every frame
@@ -447,9 +895,19 @@ void AAPosableCharacter::Tick(float DeltaTime)
 	{
 		legRaise_tickAnimation();
 	}*/
-	if (handIK_isPlaying)
+	// Remote clients receiving the replicated pose skip the solve entirely.
+	const bool bSolveLocally = !handIK_replicateSolvedPose || HasAuthority();
+	if (handIK_isPlaying && bSolveLocally)
 	{
 		handIK_tickAnimation();
+		if (handIK_replicateSolvedPose && GetNetMode() != NM_Standalone)
+		{
+			handIK_replicatePose(DeltaTime);
+		}
+	}
+	if (handIK_replicateSolvedPose && handIK_logReplicationBandwidth)
+	{
+		handIK_logBandwidth(DeltaTime);
 	}
 	if (handIKScriptedAnimationPlaying)
 	{
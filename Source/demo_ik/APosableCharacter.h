@@ -4,8 +4,24 @@
 #include "GameFramework/Actor.h"
 #include "Components/PoseableMeshComponent.h"
 #include "Components/SplineComponent.h"  // <-- for spline animation
+#include "HandIKQuery.h"
+#include "HandIKSolver.h"
+#include "IKCapsuleProxies.h"
+#include "IKPoseReplication.h"
+#include "ProceduralOscillatorSubsystem.h"
 #include "APosableCharacter.generated.h"
 
+class UDirtyPoseableMeshComponent;
+class UIKReachabilityGrid;
+
+// Bone indices of the hand IK arm chain
+struct FHandIKChainBones
+{
+	int32 UpperArm = INDEX_NONE;
+	int32 LowerArm = INDEX_NONE;
+	int32 Hand = INDEX_NONE;
+};
+
 /**
  * It is a skeletal mesh whose pose can be modified directly on the game thread (Poseable Mesh).
  * It is initialized from a source skeletal mesh component and used to display modifications such as IK.
@@ -18,7 +34,7 @@ class DEMO_IK_API AAPosableCharacter : public AActor
 public:
 	// Existing properties
 	UPROPERTY(VisibleDefaultsOnly, Category = Mesh)
-	UPoseableMeshComponent* posableMeshComponent_reference;
+	UDirtyPoseableMeshComponent* posableMeshComponent_reference;
 
 	UPROPERTY(EditAnywhere, Category = Mesh)
 	USkeletalMesh* default_skeletalMesh_reference;
@@ -29,6 +45,10 @@ public:
 	UPROPERTY(EditAnywhere, Category = "waving animation")
 	float waving_amplitude = 30.0f;
 
+	// Procedural rotation channels played by waving_playStop (plays a head nod built from speed and amplitude when empty)
+	UPROPERTY(EditAnywhere, Category = "waving animation")
+	TArray<FProceduralOscillatorChannel> waving_oscillatorChannels;
+
 	UPROPERTY(EditAnywhere, Category = "target")
 	UStaticMesh* targetSphereAsset;
 
@@ -66,12 +86,13 @@ public:
 	UPROPERTY(EditAnywhere, Category = "Advanced IK")
 	bool bEnableJointLimits = true;
 
-	// Example joint limits for the elbow (assumed to be applied on the lower arm's pitch)
+	// Example joint limits for the elbow, applied as a clamp on the lower arm's component space pitch.
+	// Not the same quantity as the bend limits baked into handIK_reachabilityGrid (bakedElbowMinBend/bakedElbowMaxBend).
 	UPROPERTY(EditAnywhere, Category = "Advanced IK")
-	float ElbowMinAngle = 0.0f;    // Minimum allowed elbow bend (degrees)
+	float ElbowMinAngle = 0.0f;    // Minimum lower arm pitch (degrees)
 
 	UPROPERTY(EditAnywhere, Category = "Advanced IK")
-	float ElbowMaxAngle = 150.0f;  // Maximum allowed elbow bend (degrees)
+	float ElbowMaxAngle = 150.0f;  // Maximum lower arm pitch (degrees)
 
 	// Flag to simulate motion capture data integration
 	UPROPERTY(EditAnywhere, Category = "Advanced IK")
@@ -81,11 +102,65 @@ public:
 	UPROPERTY(EditAnywhere, Category = "Advanced IK")
 	TMap<FName, FRotator> MotionCaptureBoneRotations;
 
+	// Keep the arm out of the body using capsules built once from the physics asset (off by default:
+	// it changes the solved pose for targets close to the torso)
+	UPROPERTY(EditAnywhere, Category = "Advanced IK")
+	bool handIK_avoidSelfCollision = false;
+
+	// Capsule radius (cm) around torso bones when the mesh has no physics asset
+	UPROPERTY(EditAnywhere, Category = "Advanced IK")
+	float handIK_fallbackCapsuleRadius = 12.0f;
+
+	// Baked workspace of the arm chain; gives seed poses and O(1) rejection of unreachable targets
+	UPROPERTY(EditAnywhere, Category = "Advanced IK")
+	UIKReachabilityGrid* handIK_reachabilityGrid = nullptr;
+
+	// FABRIK iterations run after seeding from handIK_reachabilityGrid
+	UPROPERTY(EditAnywhere, Category = "Advanced IK", meta = (ClampMin = "0"))
+	int32 handIK_seededIterations = 2;
+
+	// Hand-to-target distance (cm) above which a query reports the target as unreachable
+	UPROPERTY(EditAnywhere, Category = "Hand IK|query")
+	float handIK_queryReachTolerance = 1.0f;
+
+	// Number of random targets solved by handIK_benchmarkSelfCollision
+	UPROPERTY(EditAnywhere, Category = "Hand IK|test")
+	int32 handIK_benchmarkSolveCount = 100000;
+
+	// Replicate the solved hand IK pose: the server solves, remote clients only apply the result
+	UPROPERTY(EditAnywhere, Category = "Hand IK|replication")
+	bool handIK_replicateSolvedPose = false;
+
+	// Bones whose local rotation is replicated (must match on server and clients)
+	UPROPERTY(EditAnywhere, Category = "Hand IK|replication")
+	TArray<FName> handIK_replicatedBoneNames = { FName("upperarm_r"), FName("lowerarm_r"), FName("hand_r") };
+
+	// Viewer distance (cm) at or below which the pose is sent at the fastest rate
+	UPROPERTY(EditAnywhere, Category = "Hand IK|replication")
+	float handIK_replicationNearDistance = 500.0f;
+
+	// Viewer distance (cm) at or above which the pose is sent at the slowest rate
+	UPROPERTY(EditAnywhere, Category = "Hand IK|replication")
+	float handIK_replicationFarDistance = 5000.0f;
+
+	// Seconds between pose updates for the closest characters
+	UPROPERTY(EditAnywhere, Category = "Hand IK|replication")
+	float handIK_replicationMinInterval = 1.0f / 30.0f;
+
+	// Seconds between pose updates for the farthest characters
+	UPROPERTY(EditAnywhere, Category = "Hand IK|replication")
+	float handIK_replicationMaxInterval = 0.5f;
+
+	// Log the pose bytes sent (server) or received (client) for this character every second
+	UPROPERTY(EditAnywhere, Category = "Hand IK|replication")
+	bool handIK_logReplicationBandwidth = false;
+
 protected:
 	// Existing properties
 	UStaticMeshComponent* targetSphere;
 	UMaterialInstanceDynamic* targetSphereMaterial;
-	TArray<FRotator> waving_initialBoneRotations;
+	// Component space rotations of the starting pose, stored as float quaternions
+	TArray<FQuat4f> waving_initialBoneRotations;
 	bool session1_isPlaying = false;
 
 	// NEW: Function for leg raise animation using inverse kinematics.
@@ -100,6 +175,41 @@ protected:
 	// NEW: Scripted animation for the IK target (using a spline and ease-in/ease-out)
 	void handIK_animateTarget(float DeltaTime);
 
+	// Looks up the arm bone indices once for the current mesh (BeginPlay)
+	void handIK_cacheChainBones();
+
+	// Cached arm bones and their current component space positions; logs and returns false if one is missing
+	bool handIK_resolveChain(FHandIKChainBones& OutBones, FHandIKChain3f& OutChain) const;
+
+	// Fetches the shared body capsules for the current mesh and radius (game thread, may build them)
+	void handIK_updateBoneCapsules();
+
+	// Body capsules from the last handIK_updateBoneCapsules, moved into component space with the current pose
+	void handIK_gatherCapsules(TArray<FIKCapsuleProxy>& OutCapsules) const;
+
+	// Solved chain rotations sent to remote clients when handIK_replicateSolvedPose is set
+	UPROPERTY(ReplicatedUsing = OnRep_handIKReplicatedPose)
+	FIKReplicatedPose handIK_replicatedPose;
+
+	// Body capsules in bone space (built in BeginPlay) and in component space, refreshed before each solve
+	TSharedPtr<const TArray<FIKBoneCapsule>> handIK_boneCapsules;
+	TArray<FIKCapsuleProxy> handIK_componentSpaceCapsules;
+
+	// Arm bone indices from handIK_cacheChainBones
+	FHandIKChainBones handIK_chainBones;
+
+	TArray<int32> handIK_replicatedBoneIndices;
+	float handIK_timeSinceReplication = 0.0f;
+	float handIK_bandwidthLogTime = 0.0f;
+
+	UFUNCTION()
+	void OnRep_handIKReplicatedPose();
+
+	bool handIK_resolveReplicatedBones();
+	float handIK_computeReplicationInterval() const;
+	void handIK_replicatePose(float DeltaTime);
+	void handIK_logBandwidth(float DeltaTime);
+
 public:
 	AAPosableCharacter();
 
@@ -124,14 +234,57 @@ public:
 	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Hand IK")
 	void StartHandIKScriptedAnimation();
 
+	/**
+	 * Snapshot of the arm chain and IK settings for reachability queries. Call on the game thread;
+	 * the snapshot can then be passed to QueryHandIKBatch on worker threads. Uses the body capsules
+	 * built in BeginPlay (or by the last solve), so it never adds to the shared capsule cache.
+	 */
+	FHandIKQueryContext makeHandIKQueryContext() const;
+
+	// Solves the arm against each world target without changing the character or its mesh
+	UFUNCTION(BlueprintCallable, Category = "Hand IK|query")
+	void queryHandIKReachability(const TArray<FVector>& WorldTargets, bool bComputeRotations, TArray<bool>& OutReachable, TArray<float>& OutResidualErrors, TArray<FRotator>& OutUpperArmRotations, TArray<FRotator>& OutLowerArmRotations) const;
+
+	// Called by UPosableCharacterPoolSubsystem when the character is handed out or parked
+	void pool_onAcquired();
+	void pool_onReleased();
+
+	// Times the solver with and without the self-collision capsules and logs the cost per solve
+	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Hand IK|test")
+	void handIK_benchmarkSelfCollision();
+
 protected:
-	void storeCurrentPoseRotations(TArray<FRotator>& storedPose);
+	void storeCurrentPoseRotations(TArray<FQuat4f>& storedPose);
+	void setBoneComponentRotation(FName BoneName, const FRotator& Rotation);
 	void waving_initializeStartingPose();
+	void waving_initializeOscillators();
 	void waving_tickAnimation();
 
+	// State right after BeginPlay, restored when leaving the pool
+	TArray<FTransform> pool_restPose;
+	bool pool_restHandIKIsPlaying = false;
+	FVector pool_restTargetLocation = FVector::ZeroVector;
+
+	// Channels registered with the oscillator subsystem: the authored ones, or the generated head nod
+	TArray<FProceduralOscillatorChannel> waving_activeOscillatorChannels;
+	float waving_activeAnimationSpeed = 0.0f;
+	float waving_activeAmplitude = 0.0f;
+
+	// Unique bones driven by the oscillator channels, and the slot each channel adds into
+	TArray<int32> waving_oscillatorBoneIndices;
+	TArray<int32> waving_oscillatorChannelSlots;
+
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
 public:
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
@@ -0,0 +1,177 @@
+#include "DirtyPoseableMeshComponent.h"
+#include "demo_ik.h"
+#include "Engine/SkinnedAsset.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Bones Recomputed"), STAT_BonesRecomputed, STATGROUP_DemoIK);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Bones Total"), STAT_BonesTotal, STATGROUP_DemoIK);
+
+UDirtyPoseableMeshComponent::UDirtyPoseableMeshComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	// Cached transforms must survive between refreshes, so there is a single buffer to update in place.
+	bDoubleBufferedComponentSpaceTransforms = false;
+}
+
+void UDirtyPoseableMeshComponent::markBoneDirty(int32 BoneIndex)
+{
+	if (!bAllBonesDirty && boneDepthFirstPositions.IsValidIndex(BoneIndex))
+	{
+		dirtyPositions.Add(boneDepthFirstPositions[BoneIndex]);
+	}
+}
+
+void UDirtyPoseableMeshComponent::markBoneDirty(FName BoneName)
+{
+	markBoneDirty(GetBoneIndex(BoneName));
+}
+
+void UDirtyPoseableMeshComponent::markAllBonesDirty()
+{
+	bAllBonesDirty = true;
+	dirtyPositions.Reset();
+}
+
+bool UDirtyPoseableMeshComponent::AllocateTransformData()
+{
+	const bool bAllocated = Super::AllocateTransformData();
+	buildDepthFirstHierarchy();
+	markAllBonesDirty();
+	return bAllocated;
+}
+
+void UDirtyPoseableMeshComponent::buildDepthFirstHierarchy()
+{
+	depthFirstBones.Reset();
+	depthFirstParents.Reset();
+	depthFirstSubtreeEnds.Reset();
+	boneDepthFirstPositions.Reset();
+
+	if (!GetSkinnedAsset())
+	{
+		return;
+	}
+
+	const FReferenceSkeleton& refSkeleton = GetSkinnedAsset()->GetRefSkeleton();
+	const int32 numBones = refSkeleton.GetNum();
+
+	// The reference skeleton lists parents before children, so subtree sizes can be summed bottom-up.
+	TArray<int32> subtreeSizes;
+	subtreeSizes.Init(1, numBones);
+	for (int32 boneIndex = numBones - 1; boneIndex > 0; boneIndex--)
+	{
+		subtreeSizes[refSkeleton.GetParentIndex(boneIndex)] += subtreeSizes[boneIndex];
+	}
+
+	// Each bone goes right after its parent's already placed children (walked in index order).
+	TArray<int32> nextChildPositions;
+	nextChildPositions.SetNumUninitialized(numBones);
+	depthFirstBones.SetNumUninitialized(numBones);
+	depthFirstParents.SetNumUninitialized(numBones);
+	depthFirstSubtreeEnds.SetNumUninitialized(numBones);
+	boneDepthFirstPositions.SetNumUninitialized(numBones);
+
+	int32 nextRootPosition = 0;
+	for (int32 boneIndex = 0; boneIndex < numBones; boneIndex++)
+	{
+		const int32 parentIndex = refSkeleton.GetParentIndex(boneIndex);
+		int32& slot = parentIndex == INDEX_NONE ? nextRootPosition : nextChildPositions[parentIndex];
+		const int32 position = slot;
+		slot += subtreeSizes[boneIndex];
+
+		depthFirstBones[position] = boneIndex;
+		depthFirstParents[position] = parentIndex;
+		depthFirstSubtreeEnds[position] = position + subtreeSizes[boneIndex];
+		boneDepthFirstPositions[boneIndex] = position;
+		nextChildPositions[boneIndex] = position + 1;
+	}
+}
+
+void UDirtyPoseableMeshComponent::markChangedBones()
+{
+	for (int32 boneIndex = 0; boneIndex < BoneSpaceTransforms.Num(); boneIndex++)
+	{
+		if (!BoneSpaceTransforms[boneIndex].Equals(refreshedBoneSpaceTransforms[boneIndex], 0.0))
+		{
+			dirtyPositions.Add(boneDepthFirstPositions[boneIndex]);
+		}
+	}
+}
+
+int32 UDirtyPoseableMeshComponent::recomputeDirtySubtrees()
+{
+	const FTransform* localTransforms = BoneSpaceTransforms.GetData();
+	FTransform* componentSpaceTransforms = GetEditableComponentSpaceTransforms().GetData();
+
+	// Sorted depth-first positions make nested dirty bones fall inside the range already covered.
+	dirtyPositions.Sort();
+
+	int32 numRecomputed = 0;
+	int32 coveredEnd = 0;
+	for (const int32 dirtyPosition : dirtyPositions)
+	{
+		if (dirtyPosition < coveredEnd)
+		{
+			continue;
+		}
+		coveredEnd = depthFirstSubtreeEnds[dirtyPosition];
+		for (int32 position = dirtyPosition; position < coveredEnd; position++)
+		{
+			const int32 boneIndex = depthFirstBones[position];
+			const int32 parentIndex = depthFirstParents[position];
+			componentSpaceTransforms[boneIndex] = parentIndex == INDEX_NONE
+				? localTransforms[boneIndex]
+				: localTransforms[boneIndex] * componentSpaceTransforms[parentIndex];
+			refreshedBoneSpaceTransforms[boneIndex] = localTransforms[boneIndex];
+		}
+		numRecomputed += coveredEnd - dirtyPosition;
+	}
+	return numRecomputed;
+}
+
+void UDirtyPoseableMeshComponent::RefreshBoneTransforms(FActorComponentTickFunction* TickFunction)
+{
+	const int32 numBones = GetNumComponentSpaceTransforms();
+	const bool bHierarchyValid = depthFirstBones.Num() == numBones && BoneSpaceTransforms.Num() == numBones;
+
+	if (bAllBonesDirty || !bHierarchyValid || refreshedBoneSpaceTransforms.Num() != numBones || !GetSkinnedAsset() || numBones == 0)
+	{
+		// Full refresh through the engine path, which also (re)fills the cache.
+		Super::RefreshBoneTransforms(TickFunction);
+		if (!bHierarchyValid)
+		{
+			buildDepthFirstHierarchy();
+		}
+		bAllBonesDirty = depthFirstBones.Num() != GetNumComponentSpaceTransforms();
+		dirtyPositions.Reset();
+		refreshedBoneSpaceTransforms = BoneSpaceTransforms;
+		INC_DWORD_STAT_BY(STAT_BonesRecomputed, numBones);
+		INC_DWORD_STAT_BY(STAT_BonesTotal, numBones);
+		return;
+	}
+
+	// Nothing marked: either nothing changed since the last refresh, or the pose was written by
+	// something that does not report its bones. A pass over the local pose tells them apart.
+	if (dirtyPositions.Num() == 0)
+	{
+		markChangedBones();
+	}
+
+	const int32 numRecomputed = recomputeDirtySubtrees();
+	dirtyPositions.Reset();
+	INC_DWORD_STAT_BY(STAT_BonesRecomputed, numRecomputed);
+	INC_DWORD_STAT_BY(STAT_BonesTotal, numBones);
+
+	if (numRecomputed == 0)
+	{
+		return;
+	}
+
+	// Same follow-up as the engine refresh, without the full-skeleton fill.
+	FlipEditableSpaceBases();
+	bHasValidBoneTransform = true;
+	InvalidateCachedBounds();
+	UpdateBounds();
+	MarkRenderTransformDirty();
+	MarkRenderDynamicDataDirty();
+	UpdateChildTransforms();
+}
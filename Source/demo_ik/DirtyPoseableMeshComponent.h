@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/PoseableMeshComponent.h"
+#include "DirtyPoseableMeshComponent.generated.h"
+
+/**
+ * Poseable mesh that only recomputes the component space transforms of bones written since the
+ * last refresh, and their descendants. Everything else keeps its cached transform.
+ *
+ * Writers report the bones they touched with markBoneDirty(); anything that rewrites the whole
+ * pose (or cannot tell what it changed) calls markAllBonesDirty(). A refresh with no bone marked
+ * compares the local pose against the one it last refreshed: a clean refresh (such as the engine's
+ * per-frame call after ours) recomputes nothing, and bones written by unmarked writers (the engine
+ * setters, CopyPoseFromSkeletalComponent) are found and recomputed. The hierarchy is kept as a flat
+ * depth-first array, so the subtree of any bone is one contiguous range.
+ */
+UCLASS(ClassGroup = Rendering, meta = (BlueprintSpawnableComponent))
+class DEMO_IK_API UDirtyPoseableMeshComponent : public UPoseableMeshComponent
+{
+	GENERATED_BODY()
+
+public:
+	UDirtyPoseableMeshComponent(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	void markBoneDirty(int32 BoneIndex);
+	void markBoneDirty(FName BoneName);
+	void markAllBonesDirty();
+
+	virtual void RefreshBoneTransforms(FActorComponentTickFunction* TickFunction = nullptr) override;
+	virtual bool AllocateTransformData() override;
+
+protected:
+	void buildDepthFirstHierarchy();
+
+	// Marks the bones whose local transform differs from the last refreshed one.
+	void markChangedBones();
+
+	// Recomputes the dirty subtrees in place; returns the number of bones recomputed.
+	int32 recomputeDirtySubtrees();
+
+	// Bone index and parent bone index at each depth-first position
+	TArray<int32> depthFirstBones;
+	TArray<int32> depthFirstParents;
+	// One past the last depth-first position of the subtree rooted at each position
+	TArray<int32> depthFirstSubtreeEnds;
+	// Depth-first position of each bone index
+	TArray<int32> boneDepthFirstPositions;
+
+	// Depth-first positions of the bones written since the last refresh
+	TArray<int32> dirtyPositions;
+	bool bAllBonesDirty = true;
+
+	// Local pose as of the last refresh, per bone index
+	TArray<FTransform> refreshedBoneSpaceTransforms;
+};
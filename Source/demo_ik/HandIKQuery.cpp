@@ -0,0 +1,61 @@
+#include "HandIKQuery.h"
+#include "IKReachabilityGrid.h"
+
+void QueryHandIKBatch(const FHandIKQueryContext& Context, TArrayView<const FVector> Targets, TArrayView<FHandIKQueryResult> OutResults, bool bComputeRotations)
+{
+	check(Targets.Num() == OutResults.Num());
+
+	FHandIKSolveSettings solveSettings = Context.SolveSettings;
+	solveSettings.Capsules = Context.Capsules;
+	FHandIKSolveSettings seededSettings = solveSettings;
+	seededSettings.MaxIterations = Context.SeededIterations;
+
+	const float len1 = (Context.RestChain.Mid - Context.RestChain.Root).Size();
+	const float len2 = (Context.RestChain.End - Context.RestChain.Mid).Size();
+
+	for (int32 i = 0; i < Targets.Num(); i++)
+	{
+		const FVector3f target = FVector3f(Context.ComponentToWorld.InverseTransformPosition(Targets[i]));
+		FHandIKChain3f chain = Context.RestChain;
+		FHandIKQueryResult& result = OutResults[i];
+
+		FIKReachabilityCell reachabilityCell;
+		if (Context.ReachabilityGrid && Context.ReachabilityGrid->lookup(target - chain.Root, reachabilityCell))
+		{
+			SeedHandIKChain(chain, reachabilityCell.SeedMidDirection, target, solveSettings.Capsules);
+			if (reachabilityCell.bReachable)
+			{
+				SolveHandIKFABRIK(chain, target, seededSettings);
+			}
+		}
+		else
+		{
+			SolveHandIKFABRIK(chain, target, solveSettings);
+		}
+
+		// Reach and elbow bend limits from the target distance (law of cosines), the same test the
+		// grid bakes, so both paths agree.
+		const float distance = (target - chain.Root).Size();
+		const float cosInterior = FMath::Clamp((len1 * len1 + len2 * len2 - distance * distance) / (2.0f * FMath::Max(len1 * len2, UE_SMALL_NUMBER)), -1.0f, 1.0f);
+		const float bend = 180.0f - FMath::RadiansToDegrees(FMath::Acos(cosInterior));
+		const bool bWithinLimits = distance <= len1 + len2 && bend >= Context.ElbowMinBend && bend <= Context.ElbowMaxBend;
+
+		// Pose the arm as handIK_tickAnimation would, then measure where that pose puts the hand.
+		const FRotator3f upperRotation = FRotationMatrix44f::MakeFromX((chain.Mid - chain.Root).GetSafeNormal()).Rotator();
+		FRotator3f lowerRotation = FRotationMatrix44f::MakeFromX((chain.End - chain.Mid).GetSafeNormal()).Rotator();
+		if (Context.bEnableJointLimits)
+		{
+			lowerRotation.Pitch = FMath::Clamp(lowerRotation.Pitch, Context.ElbowMinAngle, Context.ElbowMaxAngle);
+		}
+		const FVector3f posedHand = chain.Mid + lowerRotation.Vector() * len2;
+
+		result.ResidualError = (posedHand - target).Size();
+		result.bReachable = bWithinLimits && result.ResidualError <= Context.ReachTolerance;
+
+		if (bComputeRotations)
+		{
+			result.UpperArmRotation = upperRotation.Quaternion();
+			result.LowerArmRotation = lowerRotation.Quaternion();
+		}
+	}
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HandIKSolver.h"
+
+class UIKReachabilityGrid;
+
+/**
+ * Everything a hand IK query needs, copied from a character on the game thread. Queries only
+ * read this snapshot, so they can run on any thread while the character keeps animating.
+ * The reachability grid is referenced, not copied: keep the asset alive while queries run.
+ */
+struct FHandIKQueryContext
+{
+	// Chain pose the solves start from, in component space
+	FHandIKChain3f RestChain;
+
+	// Component to world transform at capture time, used to bring world targets into component space
+	FTransform ComponentToWorld;
+
+	// Iteration settings; their capsule view is pointed at Capsules when a query runs
+	FHandIKSolveSettings SolveSettings;
+	TArray<FIKCapsuleProxy> Capsules;
+
+	const UIKReachabilityGrid* ReachabilityGrid = nullptr;
+	int32 SeededIterations = 2;
+
+	// Hand further than this from the target (cm) counts as not reaching it
+	float ReachTolerance = 1.0f;
+
+	// Elbow bend limits (degrees, 0 = straight arm), taken from the reachability grid when there is
+	// one. Checked the same way whether or not the grid is used for seeding.
+	float ElbowMinBend = 0.0f;
+	float ElbowMaxBend = 180.0f;
+
+	// Same elbow pitch clamp as handIK_tickAnimation
+	bool bEnableJointLimits = false;
+	float ElbowMinAngle = 0.0f;
+	float ElbowMaxAngle = 0.0f;
+};
+
+struct FHandIKQueryResult
+{
+	// Within reach, elbow bend within limits, and the posed hand within ReachTolerance of the target
+	bool bReachable = false;
+
+	// Distance (cm) between the posed hand (after the elbow pitch clamp) and the target
+	float ResidualError = 0.0f;
+
+	// Component space rotations of the upper and lower arm (only filled when requested)
+	FQuat4f UpperArmRotation = FQuat4f::Identity;
+	FQuat4f LowerArmRotation = FQuat4f::Identity;
+};
+
+/**
+ * Solves the chain against each world-space target without touching any component.
+ * OutResults must have as many entries as Targets.
+ */
+void QueryHandIKBatch(const FHandIKQueryContext& Context, TArrayView<const FVector> Targets, TArrayView<FHandIKQueryResult> OutResults, bool bComputeRotations);
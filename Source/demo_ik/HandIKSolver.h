@@ -0,0 +1,161 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Joint positions of a three-bone IK chain (upper arm, lower arm, hand) in component space.
+ * The solver is templated on the scalar type so the runtime path can run in float while a
+ * double-precision reference stays available for validation.
+ */
+template<typename T>
+struct THandIKChain
+{
+	UE::Math::TVector<T> Root;
+	UE::Math::TVector<T> Mid;
+	UE::Math::TVector<T> End;
+};
+
+using FHandIKChain3f = THandIKChain<float>;
+using FHandIKChain3d = THandIKChain<double>;
+
+// Capsule in component space that IK joints are kept out of (cheap stand-in for the body).
+struct FIKCapsuleProxy
+{
+	FVector3f Start;
+	FVector3f End;
+	float Radius = 0.0f;
+};
+
+// Iteration settings shared by every FABRIK solve.
+struct FHandIKSolveSettings
+{
+	int32 MaxIterations = 10;
+	float Tolerance = 0.1f;
+
+	// Joints are pushed out of these capsules after every iteration (empty = unconstrained).
+	TArrayView<const FIKCapsuleProxy> Capsules;
+};
+
+// Pushes Point to the surface of every capsule it is inside of. Pure math, no scene queries.
+template<typename T>
+void ProjectOutOfCapsules(UE::Math::TVector<T>& Point, TArrayView<const FIKCapsuleProxy> Capsules)
+{
+	using FVec = UE::Math::TVector<T>;
+
+	for (const FIKCapsuleProxy& capsule : Capsules)
+	{
+		const FVec start(capsule.Start);
+		const FVec segment = FVec(capsule.End) - start;
+		const T segmentLengthSquared = segment.SizeSquared();
+		const T alpha = segmentLengthSquared > UE_SMALL_NUMBER
+			? FMath::Clamp(FVec::DotProduct(Point - start, segment) / segmentLengthSquared, T(0), T(1))
+			: T(0);
+
+		const FVec closest = start + segment * alpha;
+		const FVec offset = Point - closest;
+		const T distanceSquared = offset.SizeSquared();
+		const T radius = static_cast<T>(capsule.Radius);
+		if (distanceSquared < radius * radius && distanceSquared > UE_SMALL_NUMBER)
+		{
+			Point = closest + offset * (radius / FMath::Sqrt(distanceSquared));
+		}
+	}
+}
+
+/**
+ * Places the chain on a precomputed seed: the elbow along MidDirection from the root, the hand
+ * aimed at Target. Segment lengths are kept, so a following FABRIK solve starts close to converged.
+ * Joints are pushed out of Capsules like in the solver, so a seed used without iterating is still valid.
+ */
+template<typename T>
+void SeedHandIKChain(THandIKChain<T>& Chain, const UE::Math::TVector<T>& MidDirection, const UE::Math::TVector<T>& Target, TArrayView<const FIKCapsuleProxy> Capsules = {})
+{
+	const T len1 = (Chain.Mid - Chain.Root).Size();
+	const T len2 = (Chain.End - Chain.Mid).Size();
+	const UE::Math::TVector<T> lowerDirection = (Chain.End - Chain.Mid).GetSafeNormal();
+
+	Chain.Mid = Chain.Root + MidDirection.GetSafeNormal() * len1;
+	if (Capsules.Num() > 0)
+	{
+		ProjectOutOfCapsules(Chain.Mid, Capsules);
+		Chain.Mid = Chain.Root + (Chain.Mid - Chain.Root).GetSafeNormal() * len1;
+	}
+
+	const UE::Math::TVector<T> toTarget = (Target - Chain.Mid).GetSafeNormal();
+	Chain.End = Chain.Mid + (toTarget.IsZero() ? lowerDirection : toTarget) * len2;
+	if (Capsules.Num() > 0)
+	{
+		ProjectOutOfCapsules(Chain.End, Capsules);
+		Chain.End = Chain.Mid + (Chain.End - Chain.Mid).GetSafeNormal() * len2;
+	}
+}
+
+/**
+ * Moves the chain towards Target using FABRIK, keeping the root fixed and the segment lengths
+ * measured from the input pose. Unreachable targets fully extend the chain towards the target.
+ * Returns true if the target was within reach.
+ */
+template<typename T>
+bool SolveHandIKFABRIK(THandIKChain<T>& Chain, const UE::Math::TVector<T>& Target, const FHandIKSolveSettings& Settings = FHandIKSolveSettings())
+{
+	using FVec = UE::Math::TVector<T>;
+
+	const T len1 = (Chain.Mid - Chain.Root).Size();
+	const T len2 = (Chain.End - Chain.Mid).Size();
+	const T totalLength = len1 + len2;
+	const T distToTarget = (Target - Chain.Root).Size();
+
+	// If the target is unreachable, fully extend the arm.
+	if (distToTarget >= totalLength)
+	{
+		const FVec dir = (Target - Chain.Root).GetSafeNormal();
+		Chain.Mid = Chain.Root + dir * len1;
+		if (Settings.Capsules.Num() > 0)
+		{
+			ProjectOutOfCapsules(Chain.Mid, Settings.Capsules);
+			Chain.Mid = Chain.Root + (Chain.Mid - Chain.Root).GetSafeNormal() * len1;
+		}
+		Chain.End = Chain.Mid + (Target - Chain.Mid).GetSafeNormal() * len2;
+		return false;
+	}
+
+	const FVec originalRoot = Chain.Root;
+	const T tolerance = static_cast<T>(Settings.Tolerance);
+
+	for (int32 iter = 0; iter < Settings.MaxIterations; iter++)
+	{
+		// Backward pass: set end effector to target.
+		Chain.End = Target;
+		FVec dir = (Chain.Mid - Chain.End).GetSafeNormal();
+		Chain.Mid = Chain.End + dir * len2;
+
+		// Forward pass: fix root and update intermediate joint.
+		Chain.Root = originalRoot;
+		dir = (Chain.Mid - Chain.Root).GetSafeNormal();
+		Chain.Mid = Chain.Root + dir * len1;
+
+		// Keep the elbow out of the body.
+		if (Settings.Capsules.Num() > 0)
+		{
+			ProjectOutOfCapsules(Chain.Mid, Settings.Capsules);
+			Chain.Mid = Chain.Root + (Chain.Mid - Chain.Root).GetSafeNormal() * len1;
+		}
+
+		// Update end effector.
+		dir = (Chain.End - Chain.Mid).GetSafeNormal();
+		Chain.End = Chain.Mid + dir * len2;
+
+		// Keep the hand out of the body, even if that leaves the target unreached.
+		if (Settings.Capsules.Num() > 0)
+		{
+			ProjectOutOfCapsules(Chain.End, Settings.Capsules);
+			Chain.End = Chain.Mid + (Chain.End - Chain.Mid).GetSafeNormal() * len2;
+		}
+
+		if ((Chain.End - Target).Size() < tolerance)
+		{
+			break;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,123 @@
+#include "IKCapsuleProxies.h"
+#include "Components/SkinnedMeshComponent.h"
+#include "Engine/SkeletalMesh.h"
+#include "PhysicsEngine/PhysicsAsset.h"
+#include "PhysicsEngine/SkeletalBodySetup.h"
+
+namespace IKCapsuleProxies
+{
+	// Bones of the chain itself, and the bone it hangs from, never push the chain.
+	static bool isPartOfChain(const FReferenceSkeleton& RefSkeleton, int32 BoneIndex, int32 ChainRootIndex)
+	{
+		if (BoneIndex == RefSkeleton.GetParentIndex(ChainRootIndex))
+		{
+			return true;
+		}
+		for (int32 index = BoneIndex; index != INDEX_NONE; index = RefSkeleton.GetParentIndex(index))
+		{
+			if (index == ChainRootIndex)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	static void buildFromPhysicsAsset(const UPhysicsAsset& PhysicsAsset, const FReferenceSkeleton& RefSkeleton, int32 ChainRootIndex, TArray<FIKBoneCapsule>& OutCapsules)
+	{
+		for (const USkeletalBodySetup* bodySetup : PhysicsAsset.SkeletalBodySetups)
+		{
+			if (!bodySetup)
+			{
+				continue;
+			}
+			const int32 boneIndex = RefSkeleton.FindBoneIndex(bodySetup->BoneName);
+			if (boneIndex == INDEX_NONE || isPartOfChain(RefSkeleton, boneIndex, ChainRootIndex))
+			{
+				continue;
+			}
+
+			for (const FKSphylElem& sphyl : bodySetup->AggGeom.SphylElems)
+			{
+				// Capsule axis is the element's local Z.
+				const FVector halfAxis = sphyl.Rotation.RotateVector(FVector::UpVector) * (sphyl.Length * 0.5f);
+				OutCapsules.Add({ boneIndex, FVector3f(sphyl.Center - halfAxis), FVector3f(sphyl.Center + halfAxis), sphyl.Radius });
+			}
+			for (const FKSphereElem& sphere : bodySetup->AggGeom.SphereElems)
+			{
+				OutCapsules.Add({ boneIndex, FVector3f(sphere.Center), FVector3f(sphere.Center), sphere.Radius });
+			}
+		}
+	}
+
+	static void buildFromBoneLengths(const FReferenceSkeleton& RefSkeleton, int32 ChainRootIndex, float Radius, TArray<FIKBoneCapsule>& OutCapsules)
+	{
+		// Walk from the bone the chain hangs from down to the skeleton root (the torso for an arm),
+		// wrapping each bone segment in a capsule. The skeleton root itself sits at the feet and is skipped.
+		const TArray<FTransform>& refPose = RefSkeleton.GetRefBonePose();
+		int32 child = RefSkeleton.GetParentIndex(ChainRootIndex);
+		for (int32 bone = RefSkeleton.GetParentIndex(child); bone > 0; child = bone, bone = RefSkeleton.GetParentIndex(bone))
+		{
+			OutCapsules.Add({ bone, FVector3f::ZeroVector, FVector3f(refPose[child].GetTranslation()), Radius });
+		}
+	}
+
+	TSharedRef<const TArray<FIKBoneCapsule>> GetOrBuild(const USkeletalMesh* Mesh, FName ChainRootBone, float FallbackRadius)
+	{
+		check(IsInGameThread());
+
+		// Entries are shared refs so callers keep a stable array while the map grows.
+		using FCacheKey = TTuple<TWeakObjectPtr<const USkeletalMesh>, FName, float>;
+		static TMap<FCacheKey, TSharedRef<const TArray<FIKBoneCapsule>>> cache;
+		static const TSharedRef<const TArray<FIKBoneCapsule>> empty = MakeShared<TArray<FIKBoneCapsule>>();
+
+		if (!Mesh)
+		{
+			return empty;
+		}
+
+		const FCacheKey key(Mesh, ChainRootBone, FallbackRadius);
+		if (const TSharedRef<const TArray<FIKBoneCapsule>>* cached = cache.Find(key))
+		{
+			return *cached;
+		}
+
+		TSharedRef<TArray<FIKBoneCapsule>> capsulesRef = MakeShared<TArray<FIKBoneCapsule>>();
+		cache.Add(key, capsulesRef);
+		TArray<FIKBoneCapsule>& capsules = *capsulesRef;
+
+		const FReferenceSkeleton& refSkeleton = Mesh->GetRefSkeleton();
+		const int32 chainRootIndex = refSkeleton.FindBoneIndex(ChainRootBone);
+		if (chainRootIndex == INDEX_NONE)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Bone %s not found!"), *ChainRootBone.ToString());
+			return capsulesRef;
+		}
+
+		if (const UPhysicsAsset* physicsAsset = Mesh->GetPhysicsAsset())
+		{
+			buildFromPhysicsAsset(*physicsAsset, refSkeleton, chainRootIndex, capsules);
+		}
+		if (capsules.Num() == 0)
+		{
+			buildFromBoneLengths(refSkeleton, chainRootIndex, FallbackRadius, capsules);
+		}
+		return capsulesRef;
+	}
+
+	void ToComponentSpace(TArrayView<const FIKBoneCapsule> BoneCapsules, const USkinnedMeshComponent& MeshComponent, TArray<FIKCapsuleProxy>& OutCapsules)
+	{
+		const TArray<FTransform>& componentSpaceTransforms = MeshComponent.GetComponentSpaceTransforms();
+
+		OutCapsules.Reset(BoneCapsules.Num());
+		for (const FIKBoneCapsule& boneCapsule : BoneCapsules)
+		{
+			if (!componentSpaceTransforms.IsValidIndex(boneCapsule.BoneIndex))
+			{
+				continue;
+			}
+			const FTransform3f boneTransform(componentSpaceTransforms[boneCapsule.BoneIndex]);
+			OutCapsules.Add({ boneTransform.TransformPosition(boneCapsule.LocalStart), boneTransform.TransformPosition(boneCapsule.LocalEnd), boneCapsule.Radius });
+		}
+	}
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HandIKSolver.h"
+
+class USkeletalMesh;
+class USkinnedMeshComponent;
+
+// Capsule attached to a bone, expressed in that bone's space.
+struct FIKBoneCapsule
+{
+	int32 BoneIndex = INDEX_NONE;
+	FVector3f LocalStart;
+	FVector3f LocalEnd;
+	float Radius = 0.0f;
+};
+
+/**
+ * Body capsules used to keep an IK chain from passing through its own skeleton.
+ * They are built once per (skeletal mesh, chain root, fallback radius) and shared by every character using that mesh.
+ */
+namespace IKCapsuleProxies
+{
+	/**
+	 * Returns the capsules for the bones that can collide with the chain starting at ChainRootBone.
+	 * Uses the mesh's physics asset when it has one, otherwise builds capsules of FallbackRadius
+	 * along the bones between the chain and the skeleton root. The returned array stays valid
+	 * however many other entries are built later. Game thread only.
+	 */
+	TSharedRef<const TArray<FIKBoneCapsule>> GetOrBuild(const USkeletalMesh* Mesh, FName ChainRootBone, float FallbackRadius);
+
+	// Moves the bone-space capsules into component space using the mesh's current pose.
+	void ToComponentSpace(TArrayView<const FIKBoneCapsule> BoneCapsules, const USkinnedMeshComponent& MeshComponent, TArray<FIKCapsuleProxy>& OutCapsules);
+}
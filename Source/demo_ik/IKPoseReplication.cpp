@@ -0,0 +1,191 @@
+#include "IKPoseReplication.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+
+namespace IKPoseQuantization
+{
+	// The three smallest components of a unit quaternion lie in [-1/sqrt(2), 1/sqrt(2)].
+	static constexpr float ComponentRange = UE_INV_SQRT_2;
+	static constexpr uint64 ComponentMax = (1ull << ComponentBits) - 1;
+
+	uint64 QuantizeSmallestThree(const FQuat4f& InRotation)
+	{
+		const FQuat4f rotation = InRotation.GetNormalized();
+		const float components[4] = { rotation.X, rotation.Y, rotation.Z, rotation.W };
+
+		int32 largestIndex = 0;
+		for (int32 i = 1; i < 4; i++)
+		{
+			if (FMath::Abs(components[i]) > FMath::Abs(components[largestIndex]))
+			{
+				largestIndex = i;
+			}
+		}
+
+		// q and -q are the same rotation, so flip the sign to make the dropped component positive.
+		const float sign = components[largestIndex] < 0.0f ? -1.0f : 1.0f;
+
+		uint64 packed = static_cast<uint64>(largestIndex);
+		int32 shift = 2;
+		for (int32 i = 0; i < 4; i++)
+		{
+			if (i == largestIndex)
+			{
+				continue;
+			}
+			const float normalized = FMath::Clamp(components[i] * sign / ComponentRange, -1.0f, 1.0f);
+			const uint64 quantized = static_cast<uint64>(FMath::RoundToInt((normalized * 0.5f + 0.5f) * ComponentMax));
+			packed |= quantized << shift;
+			shift += ComponentBits;
+		}
+		return packed;
+	}
+
+	FQuat4f DequantizeSmallestThree(uint64 Packed)
+	{
+		const int32 largestIndex = static_cast<int32>(Packed & 0x3);
+		float components[4];
+		float sumSquares = 0.0f;
+
+		int32 shift = 2;
+		for (int32 i = 0; i < 4; i++)
+		{
+			if (i == largestIndex)
+			{
+				continue;
+			}
+			const uint64 quantized = (Packed >> shift) & ComponentMax;
+			components[i] = (static_cast<float>(quantized) / ComponentMax * 2.0f - 1.0f) * ComponentRange;
+			sumSquares += components[i] * components[i];
+			shift += ComponentBits;
+		}
+		components[largestIndex] = FMath::Sqrt(FMath::Max(0.0f, 1.0f - sumSquares));
+
+		return FQuat4f(components[0], components[1], components[2], components[3]).GetNormalized();
+	}
+}
+
+// Per-connection baseline: the quantized pose as it was when last sent.
+class FIKReplicatedPoseBaseState : public INetDeltaBaseState
+{
+public:
+	TArray<uint64> QuantizedRotations;
+
+	virtual bool IsStateEqual(INetDeltaBaseState* OtherState) override
+	{
+		const FIKReplicatedPoseBaseState* other = static_cast<const FIKReplicatedPoseBaseState*>(OtherState);
+		return other && other->QuantizedRotations == QuantizedRotations;
+	}
+};
+
+void FIKReplicatedPose::SetPose(TArrayView<const FQuat4f> NewRotations)
+{
+	BoneRotations = NewRotations;
+	QuantizedRotations.SetNumUninitialized(NewRotations.Num());
+	for (int32 i = 0; i < NewRotations.Num(); i++)
+	{
+		QuantizedRotations[i] = IKPoseQuantization::QuantizeSmallestThree(NewRotations[i]);
+	}
+}
+
+int32 FIKReplicatedPose::ConsumeSerializedBytes()
+{
+	const int32 bytes = SerializedBytes;
+	SerializedBytes = 0;
+	return bytes;
+}
+
+bool FIKReplicatedPose::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+{
+	// No object references to map.
+	if (DeltaParms.GatherGuidReferences || DeltaParms.MoveGuidToUnmapped || DeltaParms.bUpdateUnmappedObjects)
+	{
+		return true;
+	}
+
+	if (DeltaParms.Writer)
+	{
+		FBitWriter& writer = *DeltaParms.Writer;
+		const FIKReplicatedPoseBaseState* oldState = static_cast<const FIKReplicatedPoseBaseState*>(DeltaParms.OldState);
+		const int32 numBones = QuantizedRotations.Num();
+
+		// Without a matching baseline (first send, or the chain changed) send every bone.
+		const bool bFullPose = !oldState || oldState->QuantizedRotations.Num() != numBones;
+
+		TBitArray<> changedBones(bFullPose, numBones);
+		if (!bFullPose)
+		{
+			bool bAnyChanged = false;
+			for (int32 i = 0; i < numBones; i++)
+			{
+				const bool bChanged = oldState->QuantizedRotations[i] != QuantizedRotations[i];
+				changedBones[i] = bChanged;
+				bAnyChanged |= bChanged;
+			}
+			if (!bAnyChanged)
+			{
+				return false;
+			}
+		}
+
+		TSharedPtr<FIKReplicatedPoseBaseState> newState = MakeShared<FIKReplicatedPoseBaseState>();
+		newState->QuantizedRotations = QuantizedRotations;
+		*DeltaParms.NewState = newState;
+
+		const int64 startBits = writer.GetNumBits();
+		writer.WriteBit(bFullPose);
+		if (bFullPose)
+		{
+			uint32 count = numBones;
+			writer.SerializeIntPacked(count);
+		}
+		for (int32 i = 0; i < numBones; i++)
+		{
+			if (!bFullPose)
+			{
+				writer.WriteBit(changedBones[i]);
+			}
+			if (changedBones[i])
+			{
+				uint64 packed = QuantizedRotations[i];
+				writer.SerializeBits(&packed, IKPoseQuantization::PackedBits);
+			}
+		}
+		SerializedBytes += static_cast<int32>((writer.GetNumBits() - startBits + 7) / 8);
+		return true;
+	}
+
+	if (DeltaParms.Reader)
+	{
+		FBitReader& reader = *DeltaParms.Reader;
+		const int64 startBits = reader.GetPosBits();
+
+		const bool bFullPose = reader.ReadBit() != 0;
+		if (bFullPose)
+		{
+			uint32 count = 0;
+			reader.SerializeIntPacked(count);
+			if (count > IKPoseQuantization::MaxBones)
+			{
+				reader.SetError();
+				return false;
+			}
+			QuantizedRotations.SetNumZeroed(count);
+			BoneRotations.SetNum(count);
+		}
+		for (int32 i = 0; i < QuantizedRotations.Num() && !reader.IsError(); i++)
+		{
+			if (bFullPose || reader.ReadBit())
+			{
+				uint64 packed = 0;
+				reader.SerializeBits(&packed, IKPoseQuantization::PackedBits);
+				QuantizedRotations[i] = packed;
+				BoneRotations[i] = IKPoseQuantization::DequantizeSmallestThree(packed);
+			}
+		}
+		SerializedBytes += static_cast<int32>((reader.GetPosBits() - startBits + 7) / 8);
+		return !reader.IsError();
+	}
+
+	return true;
+}
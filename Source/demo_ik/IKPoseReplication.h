@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/NetSerialization.h"
+#include "IKPoseReplication.generated.h"
+
+/**
+ * Smallest-three quaternion quantization: the largest component is dropped (its sign is folded
+ * into the others) and the remaining three are stored on IKPoseQuantization::ComponentBits bits each.
+ */
+namespace IKPoseQuantization
+{
+	constexpr int32 ComponentBits = 15;
+	constexpr int32 PackedBits = 2 + 3 * ComponentBits;
+	constexpr uint32 MaxBones = 256;
+
+	uint64 QuantizeSmallestThree(const FQuat4f& InRotation);
+	FQuat4f DequantizeSmallestThree(uint64 Packed);
+}
+
+/**
+ * Solved local rotations of an IK chain, replicated as smallest-three quantized quaternions.
+ * NetDeltaSerialize only sends the bones whose quantized value differs from the last pose the
+ * connection acknowledged, so a chain that holds still costs nothing on the wire.
+ */
+USTRUCT()
+struct FIKReplicatedPose
+{
+	GENERATED_BODY()
+
+	// Local (parent space) rotations, one per replicated bone
+	TArray<FQuat4f> BoneRotations;
+
+	// Quantized copy of BoneRotations, used as the delta baseline
+	TArray<uint64> QuantizedRotations;
+
+	// Bytes written (server, summed over every connection) or read (client) since the last call to ConsumeSerializedBytes
+	int32 SerializedBytes = 0;
+
+	// Quantizes and stores a new pose; the server calls this at the significance-driven rate.
+	void SetPose(TArrayView<const FQuat4f> NewRotations);
+
+	int32 ConsumeSerializedBytes();
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms);
+};
+
+template<>
+struct TStructOpsTypeTraits<FIKReplicatedPose> : public TStructOpsTypeTraitsBase2<FIKReplicatedPose>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
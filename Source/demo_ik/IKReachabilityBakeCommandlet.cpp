@@ -0,0 +1,60 @@
+#include "IKReachabilityBakeCommandlet.h"
+#include "IKReachabilityGrid.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+UIKReachabilityBakeCommandlet::UIKReachabilityBakeCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UIKReachabilityBakeCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	FString assetList;
+	if (!FParse::Value(*Params, TEXT("Assets="), assetList, false))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Usage: -run=IKReachabilityBake -Assets=/Game/Path/GridA+/Game/Path/GridB"));
+		return 1;
+	}
+
+	TArray<FString> assetPaths;
+	assetList.ParseIntoArray(assetPaths, TEXT("+"));
+
+	int32 numFailed = 0;
+	for (const FString& assetPath : assetPaths)
+	{
+		UIKReachabilityGrid* grid = LoadObject<UIKReachabilityGrid>(nullptr, *assetPath);
+		if (!grid)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Reachability grid %s not found."), *assetPath);
+			numFailed++;
+			continue;
+		}
+
+		grid->bake();
+		if (!grid->isBaked())
+		{
+			numFailed++;
+			continue;
+		}
+
+		UPackage* package = grid->GetOutermost();
+		const FString fileName = FPackageName::LongPackageNameToFilename(package->GetName(), FPackageName::GetAssetPackageExtension());
+		FSavePackageArgs saveArgs;
+		saveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+		if (!UPackage::SavePackage(package, grid, *fileName, saveArgs))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to save %s."), *fileName);
+			numFailed++;
+		}
+	}
+	return numFailed == 0 ? 0 : 1;
+#else
+	return 1;
+#endif
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "IKReachabilityBakeCommandlet.generated.h"
+
+/**
+ * Bakes and saves UIKReachabilityGrid assets.
+ * Usage: UnrealEditor-Cmd demo_ik.uproject -run=IKReachabilityBake -Assets=/Game/IK/Grid_A+/Game/IK/Grid_B
+ */
+UCLASS()
+class UIKReachabilityBakeCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UIKReachabilityBakeCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
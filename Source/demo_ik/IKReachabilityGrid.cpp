@@ -0,0 +1,244 @@
+#include "IKReachabilityGrid.h"
+#include "HandIKSolver.h"
+#include "Engine/SkeletalMesh.h"
+
+namespace IKReachabilityGridEncoding
+{
+	static constexpr uint32 ReachableBit = 1;
+	static constexpr int32 CoordinateBits = 15;
+	static constexpr uint32 CoordinateMax = (1u << CoordinateBits) - 1;
+
+	// Octahedral mapping of a unit vector onto [-1, 1]^2.
+	static uint32 packCell(bool bReachable, const FVector3f& Direction)
+	{
+		FVector3f d = Direction / FMath::Max(FMath::Abs(Direction.X) + FMath::Abs(Direction.Y) + FMath::Abs(Direction.Z), UE_SMALL_NUMBER);
+		float u = d.X;
+		float v = d.Y;
+		if (d.Z < 0.0f)
+		{
+			u = (1.0f - FMath::Abs(d.Y)) * (d.X >= 0.0f ? 1.0f : -1.0f);
+			v = (1.0f - FMath::Abs(d.X)) * (d.Y >= 0.0f ? 1.0f : -1.0f);
+		}
+		const uint32 qu = static_cast<uint32>(FMath::RoundToInt((FMath::Clamp(u, -1.0f, 1.0f) * 0.5f + 0.5f) * CoordinateMax));
+		const uint32 qv = static_cast<uint32>(FMath::RoundToInt((FMath::Clamp(v, -1.0f, 1.0f) * 0.5f + 0.5f) * CoordinateMax));
+		return (bReachable ? ReachableBit : 0u) | (qu << 1) | (qv << (1 + CoordinateBits));
+	}
+
+	static void unpackCell(uint32 Packed, FIKReachabilityCell& OutCell)
+	{
+		OutCell.bReachable = (Packed & ReachableBit) != 0;
+		const float u = static_cast<float>((Packed >> 1) & CoordinateMax) / CoordinateMax * 2.0f - 1.0f;
+		const float v = static_cast<float>((Packed >> (1 + CoordinateBits)) & CoordinateMax) / CoordinateMax * 2.0f - 1.0f;
+		FVector3f d(u, v, 1.0f - FMath::Abs(u) - FMath::Abs(v));
+		if (d.Z < 0.0f)
+		{
+			const float x = d.X;
+			d.X = (1.0f - FMath::Abs(d.Y)) * (x >= 0.0f ? 1.0f : -1.0f);
+			d.Y = (1.0f - FMath::Abs(x)) * (d.Y >= 0.0f ? 1.0f : -1.0f);
+		}
+		OutCell.SeedMidDirection = d.GetSafeNormal();
+	}
+}
+
+// Elbow direction that bends the chain by BendDegrees with the hand on the line towards the target,
+// on the side of PreferredMidDirection. Used to keep seeds inside the elbow limits.
+static FVector3f boundedBendMidDirection(const FVector3f& TargetFromRoot, const FVector3f& PreferredMidDirection, float Len1, float Len2, float BendDegrees)
+{
+	const FVector3f towardsTarget = TargetFromRoot.GetSafeNormal(UE_SMALL_NUMBER, FVector3f::ForwardVector);
+	if (Len1 <= UE_SMALL_NUMBER || Len2 <= UE_SMALL_NUMBER)
+	{
+		return towardsTarget;
+	}
+
+	// Root to hand distance for this bend, then the angle at the root between it and the upper arm.
+	const float cosBend = FMath::Cos(FMath::DegreesToRadians(BendDegrees));
+	const float handDistance = FMath::Sqrt(FMath::Max(Len1 * Len1 + Len2 * Len2 + 2.0f * Len1 * Len2 * cosBend, 0.0f));
+	const float cosRoot = handDistance > UE_SMALL_NUMBER
+		? FMath::Clamp((Len1 * Len1 + handDistance * handDistance - Len2 * Len2) / (2.0f * Len1 * handDistance), -1.0f, 1.0f)
+		: 1.0f;
+
+	FVector3f side = PreferredMidDirection - towardsTarget * FVector3f::DotProduct(PreferredMidDirection, towardsTarget);
+	if (!side.Normalize())
+	{
+		FVector3f unusedAxis;
+		towardsTarget.FindBestAxisVectors(side, unusedAxis);
+	}
+	return towardsTarget * cosRoot + side * FMath::Sqrt(1.0f - cosRoot * cosRoot);
+}
+
+bool UIKReachabilityGrid::lookup(const FVector3f& TargetFromRoot, FIKReachabilityCell& OutCell) const
+{
+	if (!lockedCells)
+	{
+		return false;
+	}
+
+	const FVector3f gridPosition = (TargetFromRoot - gridOrigin) / bakedCellSize;
+	const FIntVector cell(FMath::FloorToInt(gridPosition.X), FMath::FloorToInt(gridPosition.Y), FMath::FloorToInt(gridPosition.Z));
+	if (cell.X < 0 || cell.Y < 0 || cell.Z < 0 || cell.X >= dimensions.X || cell.Y >= dimensions.Y || cell.Z >= dimensions.Z)
+	{
+		// The grid encloses the whole reach sphere, so anything outside is too far: reach towards
+		// it as straight as the elbow limits allow.
+		OutCell.bReachable = false;
+		OutCell.SeedMidDirection = boundedBendMidDirection(TargetFromRoot, FVector3f::ZeroVector, upperArmLength, lowerArmLength, bakedElbowMinBend);
+		return true;
+	}
+
+	IKReachabilityGridEncoding::unpackCell(lockedCells[(cell.Z * dimensions.Y + cell.Y) * dimensions.X + cell.X], OutCell);
+	return true;
+}
+
+#if WITH_EDITOR
+void UIKReachabilityGrid::bake()
+{
+	if (!sourceMesh)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: no source mesh to bake from."), *GetName());
+		return;
+	}
+
+	const FReferenceSkeleton& refSkeleton = sourceMesh->GetRefSkeleton();
+	const TArray<FTransform>& refPose = refSkeleton.GetRefBonePose();
+	const int32 rootIndex = refSkeleton.FindBoneIndex(rootBoneName);
+	const int32 midIndex = refSkeleton.FindBoneIndex(midBoneName);
+	const int32 endIndex = refSkeleton.FindBoneIndex(endBoneName);
+	if (rootIndex == INDEX_NONE || midIndex == INDEX_NONE || endIndex == INDEX_NONE)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: one or more chain bones not found!"), *GetName());
+		return;
+	}
+
+	auto componentSpaceLocation = [&](int32 BoneIndex)
+	{
+		FTransform boneTransform = FTransform::Identity;
+		for (int32 index = BoneIndex; index != INDEX_NONE; index = refSkeleton.GetParentIndex(index))
+		{
+			boneTransform = boneTransform * refPose[index];
+		}
+		return FVector3f(boneTransform.GetLocation());
+	};
+
+	FHandIKChain3f restChain;
+	restChain.Root = componentSpaceLocation(rootIndex);
+	restChain.Mid = componentSpaceLocation(midIndex);
+	restChain.End = componentSpaceLocation(endIndex);
+	const float len1 = (restChain.Mid - restChain.Root).Size();
+	const float len2 = (restChain.End - restChain.Mid).Size();
+	const float reach = len1 + len2;
+	upperArmLength = len1;
+	lowerArmLength = len2;
+	bakedCellSize = cellSize;
+	bakedElbowMinBend = elbowMinBend;
+	bakedElbowMaxBend = elbowMaxBend;
+
+	// Cover the reach sphere with a margin of one cell.
+	const int32 cellsPerAxis = FMath::CeilToInt(2.0f * reach / cellSize) + 2;
+	dimensions = FIntVector(cellsPerAxis);
+	gridOrigin = FVector3f(-0.5f * cellsPerAxis * cellSize);
+
+	// The elbow side of each seed comes from a converged solve started at the rest pose, so
+	// neighbouring cells get consistent elbow placements.
+	FHandIKSolveSettings bakeSettings;
+	bakeSettings.MaxIterations = 64;
+	bakeSettings.Tolerance = 0.01f;
+
+	const int32 numCells = cellsPerAxis * cellsPerAxis * cellsPerAxis;
+	TArray<uint32> cells;
+	cells.SetNumUninitialized(numCells);
+	int32 numReachable = 0;
+
+	for (int32 z = 0; z < cellsPerAxis; z++)
+	{
+		for (int32 y = 0; y < cellsPerAxis; y++)
+		{
+			for (int32 x = 0; x < cellsPerAxis; x++)
+			{
+				const FVector3f targetFromRoot = gridOrigin + (FVector3f(x, y, z) + FVector3f(0.5f)) * cellSize;
+				const float distance = targetFromRoot.Size();
+
+				// Elbow bend needed to put the hand at this distance (law of cosines).
+				const float cosInterior = FMath::Clamp((len1 * len1 + len2 * len2 - distance * distance) / (2.0f * len1 * len2), -1.0f, 1.0f);
+				const float bend = 180.0f - FMath::RadiansToDegrees(FMath::Acos(cosInterior));
+				const bool bReachable = distance <= reach && bend >= elbowMinBend && bend <= elbowMaxBend;
+
+				FHandIKChain3f chain = restChain;
+				SolveHandIKFABRIK(chain, restChain.Root + targetFromRoot, bakeSettings);
+
+				// The solve ignores the limits: rebuild the elbow at the closest allowed bend, so
+				// out-of-limit cells get the nearest pose the arm can actually take.
+				FVector3f preferredMidDirection = chain.Mid - chain.Root;
+				if (FVector3f::CrossProduct(preferredMidDirection, targetFromRoot).IsNearlyZero())
+				{
+					preferredMidDirection = restChain.Mid - restChain.Root;
+				}
+				const float seedBend = FMath::Clamp(bend, elbowMinBend, elbowMaxBend);
+				const FVector3f seedMidDirection = boundedBendMidDirection(targetFromRoot, preferredMidDirection, len1, len2, seedBend);
+
+				cells[(z * cellsPerAxis + y) * cellsPerAxis + x] = IKReachabilityGridEncoding::packCell(bReachable, seedMidDirection);
+				numReachable += bReachable ? 1 : 0;
+			}
+		}
+	}
+
+	unlockCells();
+	cellData.Lock(LOCK_READ_WRITE);
+	FMemory::Memcpy(cellData.Realloc(numCells * sizeof(uint32)), cells.GetData(), numCells * sizeof(uint32));
+	cellData.Unlock();
+	lockCells();
+
+	MarkPackageDirty();
+	UE_LOG(LogTemp, Log, TEXT("%s: baked %d cells (%d reachable, %d KB)."), *GetName(), numCells, numReachable, static_cast<int32>(numCells * sizeof(uint32) / 1024));
+}
+#endif
+
+void UIKReachabilityGrid::Serialize(FArchive& Ar)
+{
+	Super::Serialize(Ar);
+
+	// The payload must not be locked while it is written out.
+	const bool bWasLocked = lockedCells != nullptr;
+	if (Ar.IsSaving())
+	{
+		unlockCells();
+		// Keep the cells out of the export: loading the asset's properties does not pull them in.
+		cellData.SetBulkDataFlags(BULKDATA_Force_NOT_InlinePayload);
+	}
+
+	cellData.Serialize(Ar, this);
+
+	if (Ar.IsSaving() && bWasLocked)
+	{
+		lockCells();
+	}
+}
+
+void UIKReachabilityGrid::PostLoad()
+{
+	Super::PostLoad();
+	lockCells();
+}
+
+void UIKReachabilityGrid::BeginDestroy()
+{
+	unlockCells();
+	Super::BeginDestroy();
+}
+
+void UIKReachabilityGrid::lockCells()
+{
+	const int64 expectedSize = static_cast<int64>(dimensions.X) * dimensions.Y * dimensions.Z * sizeof(uint32);
+	if (lockedCells || expectedSize == 0 || bakedCellSize <= 0.0f || cellData.GetBulkDataSize() != expectedSize)
+	{
+		return;
+	}
+	lockedCells = static_cast<const uint32*>(cellData.LockReadOnly());
+}
+
+void UIKReachabilityGrid::unlockCells()
+{
+	if (lockedCells)
+	{
+		cellData.Unlock();
+		lockedCells = nullptr;
+	}
+}
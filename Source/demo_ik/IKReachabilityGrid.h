@@ -0,0 +1,115 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Serialization/BulkData.h"
+#include "IKReachabilityGrid.generated.h"
+
+class USkeletalMesh;
+
+// What the baked grid knows about one target cell.
+struct FIKReachabilityCell
+{
+	// Reachable without breaking the elbow limits
+	bool bReachable = false;
+
+	// Direction from the chain root to the elbow for a good starting pose within the elbow limits (unit length)
+	FVector3f SeedMidDirection = FVector3f::ForwardVector;
+};
+
+/**
+ * Offline-baked workspace of a three-bone IK chain: a voxel grid around the chain root, in
+ * component space axes, where each cell stores reachability and a seed elbow direction whose
+ * bend is clamped to [elbowMinBend, elbowMaxBend]. Runtime lookups are O(1); the cell payload is
+ * bulk data stored outside the export, loaded once on PostLoad and kept locked for reads.
+ *
+ * The grid is baked against the reference pose, so it assumes the bones above the chain root
+ * (spine, clavicle) stay close to it.
+ */
+UCLASS(BlueprintType)
+class DEMO_IK_API UIKReachabilityGrid : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+#if WITH_EDITORONLY_DATA
+	// Mesh whose reference pose is sampled by bake()
+	UPROPERTY(EditAnywhere, Category = "Bake")
+	USkeletalMesh* sourceMesh = nullptr;
+#endif
+
+	UPROPERTY(EditAnywhere, Category = "Bake")
+	FName rootBoneName = FName("upperarm_r");
+
+	UPROPERTY(EditAnywhere, Category = "Bake")
+	FName midBoneName = FName("lowerarm_r");
+
+	UPROPERTY(EditAnywhere, Category = "Bake")
+	FName endBoneName = FName("hand_r");
+
+	// Cell edge length (cm)
+	UPROPERTY(EditAnywhere, Category = "Bake", meta = (ClampMin = "0.5"))
+	float cellSize = 5.0f;
+
+	// Allowed elbow bend (degrees, 0 = straight arm): the angle between the upper and lower arm,
+	// independent of where the arm points. AAPosableCharacter's ElbowMinAngle/ElbowMaxAngle are a
+	// different limit, a clamp on the lower arm's component space pitch applied after solving, and
+	// are not baked here; the bend limits only decide reachability and seed poses.
+	UPROPERTY(EditAnywhere, Category = "Bake")
+	float elbowMinBend = 0.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Bake")
+	float elbowMaxBend = 150.0f;
+
+	// Corner of the grid relative to the chain root
+	UPROPERTY(VisibleAnywhere, Category = "Grid")
+	FVector3f gridOrigin = FVector3f::ZeroVector;
+
+	UPROPERTY(VisibleAnywhere, Category = "Grid")
+	FIntVector dimensions = FIntVector::ZeroValue;
+
+	// Segment lengths of the baked chain (cm), used for seeds outside the grid
+	UPROPERTY(VisibleAnywhere, Category = "Grid")
+	float upperArmLength = 0.0f;
+
+	UPROPERTY(VisibleAnywhere, Category = "Grid")
+	float lowerArmLength = 0.0f;
+
+	// cellSize and elbow bend limits the cells were baked with. Runtime code reads only these, so
+	// editing the bake settings cannot desync lookups from the payload until the next bake().
+	UPROPERTY(VisibleAnywhere, Category = "Grid")
+	float bakedCellSize = 0.0f;
+
+	UPROPERTY(VisibleAnywhere, Category = "Grid")
+	float bakedElbowMinBend = 0.0f;
+
+	UPROPERTY(VisibleAnywhere, Category = "Grid")
+	float bakedElbowMaxBend = 0.0f;
+
+	/**
+	 * Looks up the cell containing a target given relative to the chain root, in component space.
+	 * Targets outside the grid are beyond reach and get a fully extended seed towards them.
+	 * Returns false if the grid has not been baked. Safe to call from any thread.
+	 */
+	bool lookup(const FVector3f& TargetFromRoot, FIKReachabilityCell& OutCell) const;
+
+	bool isBaked() const { return lockedCells != nullptr; }
+
+#if WITH_EDITOR
+	// Samples the source mesh's chain into the grid; also run by the IKReachabilityBake commandlet.
+	UFUNCTION(CallInEditor, Category = "Bake")
+	void bake();
+#endif
+
+	virtual void Serialize(FArchive& Ar) override;
+	virtual void PostLoad() override;
+	virtual void BeginDestroy() override;
+
+protected:
+	void lockCells();
+	void unlockCells();
+
+	// One packed uint32 per cell: bit 0 reachable, then two 15-bit octahedral coordinates of the seed
+	FByteBulkData cellData;
+	const uint32* lockedCells = nullptr;
+};
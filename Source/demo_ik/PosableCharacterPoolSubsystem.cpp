@@ -0,0 +1,124 @@
+#include "PosableCharacterPoolSubsystem.h"
+#include "APosableCharacter.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+
+bool UPosableCharacterPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UPosableCharacterPoolSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (defaultPrewarmCount > 0)
+	{
+		if (UClass* characterClass = defaultCharacterClass.LoadSynchronous())
+		{
+			prewarm(characterClass, defaultPrewarmCount);
+		}
+	}
+}
+
+AAPosableCharacter* UPosableCharacterPoolSubsystem::spawnCharacter(TSubclassOf<AAPosableCharacter> CharacterClass, const FTransform& Transform)
+{
+	FActorSpawnParameters spawnParameters;
+	spawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	return GetWorld()->SpawnActor<AAPosableCharacter>(CharacterClass, Transform, spawnParameters);
+}
+
+void UPosableCharacterPoolSubsystem::prewarm(TSubclassOf<AAPosableCharacter> CharacterClass, int32 Count)
+{
+	if (!CharacterClass)
+	{
+		return;
+	}
+
+	// OnWorldBeginPlay runs before the actors' BeginPlay is dispatched: a character spawned then
+	// would be parked first and have its tick re-enabled by its own BeginPlay afterwards.
+	UWorld* world = GetWorld();
+	if (!world->HasBegunPlay())
+	{
+		world->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &UPosableCharacterPoolSubsystem::prewarm, CharacterClass, Count));
+		return;
+	}
+
+	TArray<TObjectPtr<AAPosableCharacter>>& pool = freeCharacters.FindOrAdd(CharacterClass).characters;
+	pool.Reserve(pool.Num() + Count);
+	for (int32 i = 0; i < Count; i++)
+	{
+		// BeginPlay runs inside the spawn, once: mesh setup, starting pose and pose capture are paid up front.
+		const double startSeconds = FPlatformTime::Seconds();
+		AAPosableCharacter* character = spawnCharacter(CharacterClass, FTransform::Identity);
+		totalPrewarmSeconds += FPlatformTime::Seconds() - startSeconds;
+		numPrewarmSpawns++;
+
+		if (character)
+		{
+			character->pool_onReleased();
+			pool.Add(character);
+			parkedCharacters.Add(character);
+		}
+	}
+}
+
+AAPosableCharacter* UPosableCharacterPoolSubsystem::acquire(TSubclassOf<AAPosableCharacter> CharacterClass, const FTransform& Transform)
+{
+	if (!CharacterClass)
+	{
+		return nullptr;
+	}
+
+	FPosableCharacterPoolList* poolList = freeCharacters.Find(CharacterClass);
+	while (poolList && poolList->characters.Num() > 0)
+	{
+		const double startSeconds = FPlatformTime::Seconds();
+
+		AAPosableCharacter* character = poolList->characters.Pop(EAllowShrinking::No);
+		parkedCharacters.Remove(character);
+		if (!IsValid(character))
+		{
+			continue;
+		}
+		character->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+		character->pool_onAcquired();
+
+		totalAcquireSeconds += FPlatformTime::Seconds() - startSeconds;
+		numAcquires++;
+		return character;
+	}
+
+	// Pool exhausted: pay the full spawn cost, BeginPlay included.
+	const double startSeconds = FPlatformTime::Seconds();
+	AAPosableCharacter* character = spawnCharacter(CharacterClass, Transform);
+	totalSpawnSeconds += FPlatformTime::Seconds() - startSeconds;
+	numSpawns++;
+	return character;
+}
+
+void UPosableCharacterPoolSubsystem::release(AAPosableCharacter* Character)
+{
+	if (!IsValid(Character))
+	{
+		return;
+	}
+
+	bool bAlreadyParked = false;
+	parkedCharacters.Add(Character, &bAlreadyParked);
+	if (bAlreadyParked)
+	{
+		return;
+	}
+
+	Character->pool_onReleased();
+	freeCharacters.FindOrAdd(Character->GetClass()).characters.Add(Character);
+}
+
+void UPosableCharacterPoolSubsystem::logSpawnLatency() const
+{
+	UE_LOG(LogTemp, Log, TEXT("Posable character spawn: %.3f ms average over %d spawns, pooled acquire: %.3f ms average over %d acquires (prewarm: %.3f ms average over %d spawns)"),
+		numSpawns > 0 ? totalSpawnSeconds * 1000.0 / numSpawns : 0.0, numSpawns,
+		numAcquires > 0 ? totalAcquireSeconds * 1000.0 / numAcquires : 0.0, numAcquires,
+		numPrewarmSpawns > 0 ? totalPrewarmSeconds * 1000.0 / numPrewarmSpawns : 0.0, numPrewarmSpawns);
+}
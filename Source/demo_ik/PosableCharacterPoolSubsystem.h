@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PosableCharacterPoolSubsystem.generated.h"
+
+class AAPosableCharacter;
+
+USTRUCT()
+struct FPosableCharacterPoolList
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<AAPosableCharacter>> characters;
+};
+
+/**
+ * Keeps fully initialized AAPosableCharacter instances around so crowds can appear without the
+ * spawn-time cost (mesh setup, starting pose, pose capture). Characters are prewarmed once the
+ * world has begun play, so their BeginPlay has run before they are parked, then handed out and
+ * returned in O(1); acquiring one only restores its cached rest pose.
+ */
+UCLASS(config = Game)
+class DEMO_IK_API UPosableCharacterPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Spawns Count characters of CharacterClass and parks them hidden, with tick and collision off.
+	// Called before the world has begun play, the spawns wait for the first tick.
+	UFUNCTION(BlueprintCallable, Category = "Character Pool")
+	void prewarm(TSubclassOf<AAPosableCharacter> CharacterClass, int32 Count);
+
+	// Returns a pooled character placed at Transform, or spawns one if the pool is empty.
+	UFUNCTION(BlueprintCallable, Category = "Character Pool")
+	AAPosableCharacter* acquire(TSubclassOf<AAPosableCharacter> CharacterClass, const FTransform& Transform);
+
+	// Parks the character again for a later acquire. Releasing a character that is already parked does nothing.
+	UFUNCTION(BlueprintCallable, Category = "Character Pool")
+	void release(AAPosableCharacter* Character);
+
+	// Logs average latency of fresh spawns (pool exhausted, including BeginPlay) against pooled acquires.
+	UFUNCTION(BlueprintCallable, Category = "Character Pool")
+	void logSpawnLatency() const;
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+protected:
+	AAPosableCharacter* spawnCharacter(TSubclassOf<AAPosableCharacter> CharacterClass, const FTransform& Transform);
+
+	// Characters prewarmed on world begin play, set in DefaultGame.ini
+	UPROPERTY(config)
+	TSoftClassPtr<AAPosableCharacter> defaultCharacterClass;
+
+	UPROPERTY(config)
+	int32 defaultPrewarmCount = 0;
+
+	UPROPERTY()
+	TMap<TObjectPtr<UClass>, FPosableCharacterPoolList> freeCharacters;
+
+	// Every character currently parked in freeCharacters, to reject repeated releases
+	UPROPERTY()
+	TSet<TObjectPtr<AAPosableCharacter>> parkedCharacters;
+
+	// Spawns on an exhausted pool only; prewarm spawns are tracked separately.
+	double totalSpawnSeconds = 0.0;
+	int32 numSpawns = 0;
+	double totalPrewarmSeconds = 0.0;
+	int32 numPrewarmSpawns = 0;
+	double totalAcquireSeconds = 0.0;
+	int32 numAcquires = 0;
+};
@@ -0,0 +1,102 @@
+#include "ProceduralOscillatorSubsystem.h"
+#include "demo_ik.h"
+#include "Math/VectorRegister.h"
+
+DECLARE_CYCLE_STAT(TEXT("Oscillator Evaluate"), STAT_OscillatorEvaluate, STATGROUP_DemoIK);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Oscillator Channels"), STAT_OscillatorChannels, STATGROUP_DemoIK);
+
+void UProceduralOscillatorSubsystem::registerChannels(const UObject* Owner, TArrayView<const FProceduralOscillatorChannel> Channels)
+{
+	unregisterChannels(Owner);
+
+	FOwnerRange& range = ownerRanges.Add(Owner);
+	range.Start = numChannels;
+	range.Num = Channels.Num();
+
+	numChannels += Channels.Num();
+	const int32 paddedNum = Align(numChannels, 4);
+	frequencies.SetNumZeroed(paddedNum);
+	phases.SetNumZeroed(paddedNum);
+	amplitudes.SetNumZeroed(paddedNum);
+	lowerBounds.SetNumZeroed(paddedNum);
+	values.SetNumZeroed(paddedNum);
+
+	for (int32 i = 0; i < Channels.Num(); i++)
+	{
+		const FProceduralOscillatorChannel& channel = Channels[i];
+		frequencies[range.Start + i] = channel.Frequency;
+		phases[range.Start + i] = channel.Phase;
+		amplitudes[range.Start + i] = channel.Amplitude;
+		lowerBounds[range.Start + i] = channel.BlendCurve == EOscillatorBlendCurve::HalfSine ? 0.0f : -1.0f;
+	}
+
+	// Force a re-evaluation so the new channels have values this frame.
+	lastEvaluatedFrame = MAX_uint64;
+}
+
+void UProceduralOscillatorSubsystem::unregisterChannels(const UObject* Owner)
+{
+	FOwnerRange removed;
+	if (!ownerRanges.RemoveAndCopyValue(Owner, removed))
+	{
+		return;
+	}
+
+	// Close the gap so the arrays stay dense; owners registered later shift down.
+	for (TArray<float>* channelData : { &frequencies, &phases, &amplitudes, &lowerBounds, &values })
+	{
+		channelData->RemoveAt(removed.Start, removed.Num, EAllowShrinking::No);
+		channelData->SetNumZeroed(Align(numChannels - removed.Num, 4), EAllowShrinking::No);
+	}
+	for (TPair<TObjectKey<UObject>, FOwnerRange>& ownerRange : ownerRanges)
+	{
+		if (ownerRange.Value.Start > removed.Start)
+		{
+			ownerRange.Value.Start -= removed.Num;
+		}
+	}
+	numChannels -= removed.Num;
+}
+
+TArrayView<const float> UProceduralOscillatorSubsystem::getChannelValues(const UObject* Owner)
+{
+	const FOwnerRange* range = ownerRanges.Find(Owner);
+	if (!range)
+	{
+		return TArrayView<const float>();
+	}
+
+	if (lastEvaluatedFrame != GFrameCounter)
+	{
+		evaluateChannels(GetWorld()->GetTimeSeconds());
+		lastEvaluatedFrame = GFrameCounter;
+	}
+	return TArrayView<const float>(values.GetData() + range->Start, range->Num);
+}
+
+void UProceduralOscillatorSubsystem::evaluateChannels(float TimeSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_OscillatorEvaluate);
+	SET_DWORD_STAT(STAT_OscillatorChannels, numChannels);
+
+	const VectorRegister4Float time = VectorSetFloat1(TimeSeconds);
+	const VectorRegister4Float half = VectorSetFloat1(0.5f);
+	const VectorRegister4Float one = VectorSetFloat1(1.0f);
+	const VectorRegister4Float four = VectorSetFloat1(4.0f);
+	const VectorRegister4Float refine = VectorSetFloat1(0.225f);
+
+	for (int32 i = 0; i < numChannels; i += 4)
+	{
+		// Phase in cycles, wrapped to [-0.5, 0.5).
+		VectorRegister4Float cycles = VectorMultiplyAdd(VectorLoad(&frequencies[i]), time, VectorLoad(&phases[i]));
+		cycles = VectorSubtract(cycles, VectorFloor(VectorAdd(cycles, half)));
+
+		// sin(2 * PI * cycles) with a parabola plus one refinement step (max error ~0.001).
+		const VectorRegister4Float halfCycles = VectorAdd(cycles, cycles);
+		VectorRegister4Float sine = VectorMultiply(VectorMultiply(four, halfCycles), VectorSubtract(one, VectorAbs(halfCycles)));
+		sine = VectorMultiplyAdd(refine, VectorSubtract(VectorMultiply(sine, VectorAbs(sine)), sine), sine);
+
+		sine = VectorMax(sine, VectorLoad(&lowerBounds[i]));
+		VectorStore(VectorMultiply(sine, VectorLoad(&amplitudes[i])), &values[i]);
+	}
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "ProceduralOscillatorSubsystem.generated.h"
+
+UENUM(BlueprintType)
+enum class EOscillatorAxis : uint8
+{
+	Roll,
+	Pitch,
+	Yaw
+};
+
+UENUM(BlueprintType)
+enum class EOscillatorBlendCurve : uint8
+{
+	// Full sine wave, negative half included
+	Sine,
+	// Positive half of the sine only; the channel rests for the other half of the cycle
+	HalfSine
+};
+
+// One procedural rotation channel: Amplitude * curve(Frequency * time + Phase) added on a bone axis.
+USTRUCT(BlueprintType)
+struct FProceduralOscillatorChannel
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Oscillator")
+	FName BoneName = NAME_None;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Oscillator")
+	EOscillatorAxis Axis = EOscillatorAxis::Yaw;
+
+	// Cycles per second
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Oscillator")
+	float Frequency = 1.0f;
+
+	// Offset in cycles (0.5 = half a cycle)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Oscillator")
+	float Phase = 0.0f;
+
+	// Peak rotation in degrees
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Oscillator")
+	float Amplitude = 10.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Oscillator")
+	EOscillatorBlendCurve BlendCurve = EOscillatorBlendCurve::Sine;
+};
+
+/**
+ * Evaluates the oscillator channels of every registered character in one batched pass per frame.
+ * Channel parameters live in flat arrays so the kernel runs four channels per SIMD register;
+ * owners then read back their slice of angles (degrees) and apply them to their bones.
+ */
+UCLASS()
+class DEMO_IK_API UProceduralOscillatorSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	void registerChannels(const UObject* Owner, TArrayView<const FProceduralOscillatorChannel> Channels);
+	void unregisterChannels(const UObject* Owner);
+
+	// Angles for the owner's channels, in registration order. Evaluates all channels on the first call of a frame.
+	TArrayView<const float> getChannelValues(const UObject* Owner);
+
+protected:
+	void evaluateChannels(float TimeSeconds);
+
+	struct FOwnerRange
+	{
+		int32 Start = 0;
+		int32 Num = 0;
+	};
+
+	TMap<TObjectKey<UObject>, FOwnerRange> ownerRanges;
+
+	// Flat channel data, padded to a multiple of four
+	TArray<float> frequencies;
+	TArray<float> phases;
+	TArray<float> amplitudes;
+	// -1 lets the full sine through, 0 clips it to the positive half
+	TArray<float> lowerBounds;
+	TArray<float> values;
+
+	int32 numChannels = 0;
+	uint64 lastEvaluatedFrame = MAX_uint64;
+};
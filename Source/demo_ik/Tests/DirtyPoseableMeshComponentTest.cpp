@@ -0,0 +1,87 @@
+#include "DirtyPoseableMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDirtyPoseableMeshRefreshTest, "DemoIK.PoseableMesh.PartialRefreshMatchesFull",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FDirtyPoseableMeshRefreshTest::RunTest(const FString& Parameters)
+{
+	USkeletalMesh* mesh = LoadObject<USkeletalMesh>(nullptr, TEXT("/Game/Characters/Mannequins/Meshes/SKM_Manny_Simple"));
+	if (!TestNotNull(TEXT("Mannequin mesh"), mesh))
+	{
+		return false;
+	}
+
+	UWorld* world = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& worldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	worldContext.SetCurrentWorld(world);
+
+	// partial only ever sees the marked bones; full recomputes everything through the engine path.
+	UDirtyPoseableMeshComponent* partial = NewObject<UDirtyPoseableMeshComponent>(world);
+	UDirtyPoseableMeshComponent* full = NewObject<UDirtyPoseableMeshComponent>(world);
+	for (UDirtyPoseableMeshComponent* component : { partial, full })
+	{
+		component->SetSkinnedAssetAndUpdate(mesh);
+		component->RegisterComponentWithWorld(world);
+		component->RefreshBoneTransforms();
+	}
+
+	const int32 numBones = partial->GetNumComponentSpaceTransforms();
+	TestTrue(TEXT("Mesh has bones"), numBones > 0);
+
+	auto compare = [&](const TCHAR* What, int32 Round)
+	{
+		const TArray<FTransform>& partialTransforms = partial->GetComponentSpaceTransforms();
+		const TArray<FTransform>& fullTransforms = full->GetComponentSpaceTransforms();
+		int32 numMismatches = 0;
+		for (int32 boneIndex = 0; boneIndex < numBones; boneIndex++)
+		{
+			numMismatches += partialTransforms[boneIndex].Equals(fullTransforms[boneIndex], 1.0e-3) ? 0 : 1;
+		}
+		TestEqual(FString::Printf(TEXT("%s, round %d: bones differing from the full refresh"), What, Round), numMismatches, 0);
+	};
+
+	FRandomStream random(1234);
+	for (int32 round = 0; round < 32; round++)
+	{
+		// Rotate a random set of bones, some of them nested in each other's subtrees.
+		const int32 numWrites = random.RandRange(1, 8);
+		for (int32 write = 0; write < numWrites; write++)
+		{
+			const int32 boneIndex = random.RandRange(0, numBones - 1);
+			const FQuat rotation = FQuat(random.GetUnitVector(), random.FRandRange(-0.5f, 0.5f)) * partial->BoneSpaceTransforms[boneIndex].GetRotation();
+			partial->BoneSpaceTransforms[boneIndex].SetRotation(rotation);
+			full->BoneSpaceTransforms[boneIndex].SetRotation(rotation);
+
+			// Every fourth round leaves the writes unmarked, like the engine setters do.
+			if (round % 4 != 3)
+			{
+				partial->markBoneDirty(boneIndex);
+			}
+		}
+
+		partial->RefreshBoneTransforms();
+		full->markAllBonesDirty();
+		full->RefreshBoneTransforms();
+		compare(round % 4 != 3 ? TEXT("Marked writes") : TEXT("Unmarked writes"), round);
+
+		// A second refresh with nothing written must leave the cache as it is.
+		partial->RefreshBoneTransforms();
+		compare(TEXT("Clean refresh"), round);
+	}
+
+	for (UDirtyPoseableMeshComponent* component : { partial, full })
+	{
+		component->UnregisterComponent();
+	}
+	GEngine->DestroyWorldContext(world);
+	world->DestroyWorld(false);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,55 @@
+#include "HandIKSolver.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHandIKSolverFloatPrecisionTest, "DemoIK.HandIK.FloatPrecision",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FHandIKSolverFloatPrecisionTest::RunTest(const FString& Parameters)
+{
+	// Right arm of the mannequin in component space: shoulder height, 30 cm upper arm, 27 cm forearm.
+	FHandIKChain3d referenceChain;
+	referenceChain.Root = FVector(-16.0, 3.5, 145.0);
+	referenceChain.Mid = referenceChain.Root + FVector(-4.0, 0.0, -29.7);
+	referenceChain.End = referenceChain.Mid + FVector(8.0, 3.0, -25.6);
+	const double reach = (referenceChain.Mid - referenceChain.Root).Size() + (referenceChain.End - referenceChain.Mid).Size();
+
+	// No early exit, so both precisions run the same number of iterations and only rounding differs.
+	FHandIKSolveSettings settings;
+	settings.MaxIterations = 10;
+	settings.Tolerance = 0.0f;
+	const double errorBound = 0.01;
+
+	// Targets on a grid around the shoulder, inside and outside reach. An even sample count keeps
+	// the root itself, where the solve direction is undefined, off the grid.
+	const int32 samplesPerAxis = 8;
+	double maxError = 0.0;
+	for (int32 x = 0; x < samplesPerAxis; x++)
+	{
+		for (int32 y = 0; y < samplesPerAxis; y++)
+		{
+			for (int32 z = 0; z < samplesPerAxis; z++)
+			{
+				const FVector offset = (FVector(x, y, z) / (samplesPerAxis - 1) * 2.0 - FVector(1.0)) * reach * 1.25;
+				const FVector target = referenceChain.Root + offset;
+
+				FHandIKChain3d doubleChain = referenceChain;
+				const bool bDoubleReached = SolveHandIKFABRIK(doubleChain, target, settings);
+
+				FHandIKChain3f floatChain{ FVector3f(referenceChain.Root), FVector3f(referenceChain.Mid), FVector3f(referenceChain.End) };
+				const bool bFloatReached = SolveHandIKFABRIK(floatChain, FVector3f(target), settings);
+
+				TestEqual(FString::Printf(TEXT("Reachability of target %s"), *offset.ToString()), bFloatReached, bDoubleReached);
+				maxError = FMath::Max(maxError, (FVector(floatChain.Mid) - doubleChain.Mid).Size());
+				maxError = FMath::Max(maxError, (FVector(floatChain.End) - doubleChain.End).Size());
+			}
+		}
+	}
+
+	AddInfo(FString::Printf(TEXT("Float solve within %f cm of the double solve."), maxError));
+	TestTrue(FString::Printf(TEXT("Float deviation %f cm within %f cm"), maxError, errorBound), maxError <= errorBound);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,91 @@
+#include "IKPoseReplication.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FIKPoseQuantizationTest, "DemoIK.HandIK.PoseQuantization",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FIKPoseQuantizationTest::RunTest(const FString& Parameters)
+{
+	// 2 + 3x15 bits keep every rotation within about 0.04 degrees.
+	const double errorBoundRadians = 1.0e-3;
+
+	FRandomStream random(1234);
+	double maxError = 0.0;
+	for (int32 i = 0; i < 10000; i++)
+	{
+		const FQuat4f rotation = FQuat4f(FVector3f(random.GetUnitVector()), random.FRandRange(-UE_PI, UE_PI));
+		const FQuat4f dequantized = IKPoseQuantization::DequantizeSmallestThree(IKPoseQuantization::QuantizeSmallestThree(rotation));
+
+		// Measured in double: the float acos cannot resolve angles this small.
+		maxError = FMath::Max(maxError, FQuat(rotation).AngularDistance(FQuat(dequantized)));
+	}
+
+	AddInfo(FString::Printf(TEXT("Largest dequantization error %f rad."), maxError));
+	TestTrue(FString::Printf(TEXT("Dequantization error %f rad within %f rad"), maxError, errorBoundRadians), maxError <= errorBoundRadians);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FIKPoseDeltaSerializationTest, "DemoIK.HandIK.PoseDeltaSerialization",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FIKPoseDeltaSerializationTest::RunTest(const FString& Parameters)
+{
+	FIKReplicatedPose serverPose;
+	FIKReplicatedPose clientPose;
+	TSharedPtr<INetDeltaBaseState> baseState;
+
+	// Serializes the server pose against baseState into the client pose; returns the bits sent (-1 if nothing was).
+	auto replicate = [&]() -> int64
+	{
+		FBitWriter writer(0, true);
+		TSharedPtr<INetDeltaBaseState> newState;
+		FNetDeltaSerializeInfo writeParms;
+		writeParms.Writer = &writer;
+		writeParms.OldState = baseState.Get();
+		writeParms.NewState = &newState;
+		if (!serverPose.NetDeltaSerialize(writeParms))
+		{
+			return -1;
+		}
+		baseState = newState;
+
+		FBitReader reader(writer.GetData(), writer.GetNumBits());
+		FNetDeltaSerializeInfo readParms;
+		readParms.Reader = &reader;
+		TestTrue(TEXT("Client reads the pose"), clientPose.NetDeltaSerialize(readParms));
+		return writer.GetNumBits();
+	};
+
+	TArray<FQuat4f> rotations;
+	FRandomStream random(1234);
+	for (int32 i = 0; i < 8; i++)
+	{
+		rotations.Add(FQuat4f(FVector3f(random.GetUnitVector()), random.FRandRange(-UE_PI, UE_PI)));
+	}
+
+	// First send: full pose.
+	serverPose.SetPose(rotations);
+	const int64 fullPoseBits = replicate();
+	TestTrue(TEXT("Full pose sent"), fullPoseBits > 0);
+	TestTrue(TEXT("Full pose matches"), clientPose.QuantizedRotations == serverPose.QuantizedRotations);
+	TestEqual(TEXT("Full pose bone count"), clientPose.BoneRotations.Num(), rotations.Num());
+
+	// Unchanged pose: nothing on the wire.
+	TestEqual(TEXT("Unchanged pose is not sent"), replicate(), int64(-1));
+
+	// One bone moved: only that bone is sent.
+	rotations[3] = FQuat4f(FVector3f::UpVector, 0.5f) * rotations[3];
+	serverPose.SetPose(rotations);
+	const int64 deltaPoseBits = replicate();
+	TestTrue(TEXT("Delta pose sent"), deltaPoseBits > 0);
+	TestTrue(FString::Printf(TEXT("Delta pose (%lld bits) smaller than full pose (%lld bits)"), deltaPoseBits, fullPoseBits), deltaPoseBits < fullPoseBits);
+	TestTrue(TEXT("Delta pose matches"), clientPose.QuantizedRotations == serverPose.QuantizedRotations);
+	TestTrue(TEXT("Moved bone dequantized on the client"), clientPose.BoneRotations[3].Equals(IKPoseQuantization::DequantizeSmallestThree(serverPose.QuantizedRotations[3])));
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS